@@ -0,0 +1,110 @@
+/**
+ * Benchmark Model Families
+ * Generators for scalable timed-automata families in TCK format, modelled after
+ * the families of the tchecker test suite. Each generator returns the model text
+ * and the labels to search for.
+ */
+
+/**
+ * Fischer's mutual exclusion protocol
+ * N processes share `id`; each waits more than K time units after writing it.
+ * The two critical-section labels are never reached together, so reachability
+ * runs explore the whole state space.
+ * @param {number} n - Number of processes
+ * @param {number} k - Timing constant
+ * @returns {object} - { name, tck, reachLabels, livenessLabels }
+ */
+function fischer(n, k) {
+  const lines = [`system:fischer_${n}_${k}{}`, '', 'event:tau{}', `int:1:0:${n}:0:id{}`]
+
+  for (let i = 1; i <= n; i++) {
+    const p = `P${i}`
+    const x = `x${i}`
+    lines.push(
+      '',
+      `process:${p}{}`,
+      `clock:1:${x}{}`,
+      `location:${p}:A{initial:}`,
+      `location:${p}:req{invariant:${x}<=${k}}`,
+      `location:${p}:wait{}`,
+      `location:${p}:cs{labels:cs${i}}`,
+      `edge:${p}:A:req:tau{provided:id==0:do:${x}=0}`,
+      `edge:${p}:req:wait:tau{provided:${x}<=${k}:do:${x}=0;id=${i}}`,
+      `edge:${p}:wait:req:tau{provided:id==0:do:${x}=0}`,
+      `edge:${p}:wait:cs:tau{provided:${x}>${k}&&id==${i}}`,
+      `edge:${p}:cs:A:tau{do:id=0}`
+    )
+  }
+
+  return {
+    name: `fischer_${n}_${k}`,
+    tck: `${lines.join('\n')}\n`,
+    reachLabels: ['cs1', 'cs2'],
+    livenessLabels: ['cs1']
+  }
+}
+
+/**
+ * Timed dining philosophers
+ * Forks are shared variables. A philosopher holding its left fork gives it back
+ * when the right one is not free within `timeout`, and eats for `eat` time units.
+ * @param {number} n - Number of philosophers
+ * @param {number} timeout - Maximum wait for the right fork
+ * @param {number} eat - Eating time
+ * @returns {object} - { name, tck, reachLabels, livenessLabels }
+ */
+function diningPhilosophers(n, timeout, eat) {
+  const lines = [`system:dining_philosophers_${n}_${timeout}_${eat}{}`, '', 'event:tau{}']
+  for (let i = 0; i < n; i++) {
+    lines.push(`int:1:0:1:0:fork${i}{}`)
+  }
+
+  for (let i = 0; i < n; i++) {
+    const p = `Phil${i}`
+    const x = `x${i}`
+    const left = `fork${i}`
+    const right = `fork${(i + 1) % n}`
+    lines.push(
+      '',
+      `process:${p}{}`,
+      `clock:1:${x}{}`,
+      `location:${p}:think{initial:}`,
+      `location:${p}:hasLeft{invariant:${x}<=${timeout}}`,
+      `location:${p}:eating{invariant:${x}<=${eat}:labels:eat${i}}`,
+      `edge:${p}:think:hasLeft:tau{provided:${left}==0:do:${left}=1;${x}=0}`,
+      `edge:${p}:hasLeft:eating:tau{provided:${right}==0:do:${right}=1;${x}=0}`,
+      `edge:${p}:hasLeft:think:tau{provided:${x}>=${timeout}:do:${left}=0}`,
+      `edge:${p}:eating:think:tau{provided:${x}>=${eat}:do:${left}=0;${right}=0;${x}=0}`
+    )
+  }
+
+  return {
+    name: `dining_philosophers_${n}_${timeout}_${eat}`,
+    tck: `${lines.join('\n')}\n`,
+    reachLabels: ['eat0', `eat${n - 1}`],
+    livenessLabels: ['eat0']
+  }
+}
+
+// Instances per scale; 'small' stays under a second per run on a laptop
+const SCALES = {
+  small: [fischer(3, 10), fischer(4, 10), diningPhilosophers(3, 3, 10)],
+  medium: [
+    fischer(5, 10),
+    fischer(6, 10),
+    diningPhilosophers(4, 3, 10),
+    diningPhilosophers(5, 3, 10)
+  ],
+  large: [
+    fischer(7, 10),
+    fischer(8, 10),
+    diningPhilosophers(6, 3, 10),
+    diningPhilosophers(7, 3, 10)
+  ]
+}
+
+module.exports = {
+  fischer,
+  diningPhilosophers,
+  SCALES
+}
@@ -0,0 +1,256 @@
+#!/usr/bin/env node
+/**
+ * micro-bench
+ * Microbenchmarks of the main-process primitives on the verification and
+ * simulation paths: TCK generation, model hashing, property fingerprints, DOT
+ * certificate parsing, statistics parsing and simulator screen parsing.
+ *
+ * Each case runs for a fixed time budget after a warm-up, in several samples;
+ * the report gives the median time per operation and the spread between
+ * samples, so that regressions larger than the noise can be told apart.
+ *
+ * Usage: node scripts/micro-bench.js [--filter name] [--size N] [--samples N]
+ *          [--out report.json] [--baseline report.json] [--tolerance 0.15]
+ */
+
+const fs = require('fs')
+const { generateTckFromJSON } = require('../src/main/utils/tck-generator')
+const { hashContent } = require('../src/main/utils/model-cache')
+const { propertyFingerprint } = require('../src/main/utils/property-fingerprint')
+const { parseDot } = require('../src/main/utils/dot-parser')
+const { parseStats } = require('../src/main/utils/stats-parser')
+const { parseScreen } = require('../src/main/utils/simulation-session')
+
+const SAMPLE_MS = 200
+const WARMUP_MS = 100
+
+function parseArgs(argv) {
+  const options = { filter: null, size: 8, samples: 7, out: null, baseline: null, tolerance: 0.15 }
+  for (let i = 0; i < argv.length; i += 2) {
+    const value = argv[i + 1]
+    switch (argv[i]) {
+      case '--filter':
+        options.filter = value
+        break
+      case '--size':
+        options.size = parseInt(value)
+        break
+      case '--samples':
+        options.samples = Math.max(3, parseInt(value))
+        break
+      case '--out':
+        options.out = value
+        break
+      case '--baseline':
+        options.baseline = value
+        break
+      case '--tolerance':
+        options.tolerance = parseFloat(value)
+        break
+      default:
+        throw new Error(`Unknown option ${argv[i]}`)
+    }
+  }
+  return options
+}
+
+/**
+ * JSON model of N Fischer processes, in the shape sent by the renderer
+ */
+function fischerModel(n) {
+  const processes = {}
+  for (let i = 1; i <= n; i++) {
+    processes[`P${i}`] = {
+      locations: {
+        A: { isInitial: true },
+        req: { invariant: `x${i}<=10` },
+        wait: {},
+        cs: { labels: [`cs${i}`] }
+      },
+      edges: [
+        { source: 'A', target: 'req', event: 'tau', guard: 'id==0', action: `x${i}=0` },
+        {
+          source: 'req',
+          target: 'wait',
+          event: 'tau',
+          guard: `x${i}<=10`,
+          action: `x${i}=0;id=${i}`
+        },
+        { source: 'wait', target: 'req', event: 'tau', guard: 'id==0', action: `x${i}=0` },
+        { source: 'wait', target: 'cs', event: 'tau', guard: `x${i}>10&&id==${i}` },
+        { source: 'cs', target: 'A', event: 'tau', action: 'id=0' }
+      ]
+    }
+  }
+  return {
+    systemName: `fischer_${n}`,
+    events: ['tau'],
+    clocks: Array.from({ length: n }, (_, i) => ({ name: `x${i + 1}`, size: 1 })),
+    intVars: [{ name: 'id', size: 1, min: 0, max: n, initial: 0 }],
+    processes,
+    synchronizations: []
+  }
+}
+
+const LOCATIONS = ['A', 'req', 'wait', 'cs']
+
+/**
+ * Certificate in the layout written by tck-reach -C concrete/symbolic, with `states` nodes
+ */
+function certificate(states, processes) {
+  const lines = ['digraph fischer {', '  node [shape="box", style="rounded"];']
+  for (let s = 0; s < states; s++) {
+    const vloc = Array.from({ length: processes }, (_, p) => LOCATIONS[(s + p) % LOCATIONS.length])
+    const zone = Array.from({ length: processes }, (_, p) => `0<=x${p + 1}<=10`).join(' & ')
+    lines.push(
+      `  ${s} [${s === 0 ? 'initial="true", ' : ''}intval="id=${s % processes}", ` +
+        `labels="", vloc="<${vloc.join(',')}>", zone="(${zone})"]`
+    )
+  }
+  for (let s = 1; s < states; s++) {
+    lines.push(`  ${s - 1} -> ${s} [vedge="<P${(s % processes) + 1}@tau>"]`)
+  }
+  lines.push('}')
+  return lines.join('\n')
+}
+
+function statsOutput() {
+  return [
+    'COVERED_STATES 123',
+    'MEMORY_MAX_RSS 10485760',
+    'REACHABLE false',
+    'RUNNING_TIME_SECONDS 0.5321',
+    'STORED_STATES 45678',
+    'VISITED_STATES 56789',
+    'VISITED_TRANSITIONS 98765'
+  ].join('\n')
+}
+
+function simulatorScreen(successors, processes) {
+  const state = (s) =>
+    `\tintval: id=${s}\n\tvloc: <${Array(processes).fill('wait').join(',')}>\n` +
+    `\tzone: (${Array.from({ length: processes }, (_, p) => `0<=x${p + 1}`).join(' & ')})\n`
+  let text = `--- Current state: \n${state(0)}--- Successors: \n`
+  for (let k = 0; k < successors; k++) {
+    text += `${k}) \tvedge: <P${k + 1}@tau>\n\tguard: id==0\n\treset: x${k + 1}=0\n${state(k)}`
+  }
+  return text
+}
+
+function buildCases(size) {
+  const model = fischerModel(size)
+  const tck = generateTckFromJSON(model)
+  const dotSmall = certificate(100, size)
+  const dotLarge = certificate(10000, size)
+  const stats = statsOutput()
+  const screen = simulatorScreen(size, size)
+  const property = { type: 'reachability', targetLabel: 'cs1' }
+
+  return [
+    { name: 'tck-generate', bytes: tck.length, fn: () => generateTckFromJSON(model) },
+    { name: 'model-hash', bytes: tck.length, fn: () => hashContent(tck) },
+    {
+      name: 'property-fingerprint',
+      bytes: tck.length,
+      fn: () => propertyFingerprint(tck, property)
+    },
+    { name: 'dot-parse-100', bytes: dotSmall.length, fn: () => parseDot(dotSmall) },
+    { name: 'dot-parse-10000', bytes: dotLarge.length, fn: () => parseDot(dotLarge) },
+    { name: 'stats-parse', bytes: stats.length, fn: () => parseStats(stats) },
+    { name: 'screen-parse', bytes: screen.length, fn: () => parseScreen(screen) },
+    {
+      // What the GUI view costs: every successor's transition and state materialized
+      name: 'screen-parse-view',
+      bytes: screen.length,
+      fn: () => parseScreen(screen).successors.map((entry) => entry.attributes)
+    }
+  ]
+}
+
+/**
+ * Time one case: operations per sample are calibrated during warm-up so that a
+ * sample takes about SAMPLE_MS
+ * @returns {object} - { nsPerOp, spread, iterations } with spread relative to nsPerOp
+ */
+function measure(fn, samples) {
+  let sink = null
+  let iterations = 1
+  const warmupEnd = Date.now() + WARMUP_MS
+  while (Date.now() < warmupEnd) {
+    const start = process.hrtime.bigint()
+    for (let i = 0; i < iterations; i++) sink = fn()
+    const elapsedMs = Number(process.hrtime.bigint() - start) / 1e6
+    if (elapsedMs < SAMPLE_MS / 10) iterations *= 2
+  }
+  iterations = Math.max(1, iterations * 10)
+
+  const perOp = []
+  for (let s = 0; s < samples; s++) {
+    const start = process.hrtime.bigint()
+    for (let i = 0; i < iterations; i++) sink = fn()
+    perOp.push(Number(process.hrtime.bigint() - start) / iterations)
+  }
+  if (sink === undefined) throw new Error('benchmark returned nothing')
+
+  perOp.sort((a, b) => a - b)
+  const median = perOp[Math.floor(perOp.length / 2)]
+  const deviations = perOp.map((t) => Math.abs(t - median)).sort((a, b) => a - b)
+  const mad = deviations[Math.floor(deviations.length / 2)]
+  return { nsPerOp: median, spread: mad / median, iterations }
+}
+
+function formatNs(ns) {
+  if (ns >= 1e6) return `${(ns / 1e6).toFixed(2)}ms`
+  if (ns >= 1e3) return `${(ns / 1e3).toFixed(2)}us`
+  return `${ns.toFixed(0)}ns`
+}
+
+function main() {
+  const options = parseArgs(process.argv.slice(2))
+  const results = []
+
+  for (const testCase of buildCases(options.size)) {
+    if (options.filter && !testCase.name.includes(options.filter)) continue
+    const { nsPerOp, spread, iterations } = measure(testCase.fn, options.samples)
+    const mbPerSecond = testCase.bytes / nsPerOp / 1.048576e-3
+    results.push({
+      name: testCase.name,
+      size: options.size,
+      nsPerOp,
+      spread,
+      iterations,
+      mbPerSecond
+    })
+    console.error(
+      `${testCase.name.padEnd(22)} ${formatNs(nsPerOp).padStart(10)}/op  ` +
+        `±${(spread * 100).toFixed(1)}%  ${mbPerSecond.toFixed(1)} MB/s`
+    )
+  }
+
+  const report = { date: new Date().toISOString(), node: process.version, results }
+  const json = JSON.stringify(report, null, 2)
+  if (options.out) fs.writeFileSync(options.out, `${json}\n`)
+  else console.log(json)
+
+  if (options.baseline) {
+    const baseline = new Map(
+      JSON.parse(fs.readFileSync(options.baseline, 'utf8')).results.map((r) => [r.name, r])
+    )
+    let regressions = 0
+    for (const result of results) {
+      const before = baseline.get(result.name)
+      if (!before || before.size !== result.size) continue
+      // A slowdown within the measured noise of either run is not reported
+      const allowed = options.tolerance + before.spread + result.spread
+      if (result.nsPerOp > before.nsPerOp * (1 + allowed)) {
+        regressions++
+        console.error(
+          `REGRESSION ${result.name}: ${formatNs(before.nsPerOp)} -> ${formatNs(result.nsPerOp)}`
+        )
+      }
+    }
+    if (regressions > 0) process.exitCode = 1
+  }
+}
+
+main()
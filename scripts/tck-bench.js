@@ -0,0 +1,363 @@
+#!/usr/bin/env node
+/**
+ * tck-bench
+ * Runs the benchmark model families through tck-reach (reach, covreach) and
+ * tck-liveness (ndfs, couvscc), and writes a machine-readable report with wall
+ * time, peak RSS and throughput per run. With --baseline, compares against an
+ * earlier report and exits with status 1 when a run got slower or bigger than
+ * the allowed tolerance.
+ *
+ * Usage: node scripts/tck-bench.js [--scale small|medium|large] [--repeat N]
+ *          [--out report.json] [--baseline report.json] [--tolerance 0.10]
+ *          [--algorithms reach,covreach,ndfs,couvscc] [--perf]
+ *          [--hugepages] [--numa interleave|local] [--table-size N|auto]
+ *          [--block-size N|auto]
+ * The binaries are taken from TCHECKER_BIN_DIR or src/main/build/src. With --perf,
+ * runs are counted with perf stat (Linux) and the report adds IPC and cache/TLB
+ * misses per visited state. --hugepages and --numa set the memory backing of the
+ * tools (see src/main/utils/memory-backing.js); run once without and once with,
+ * the first report as --baseline, to measure their effect on the large scale.
+ * --table-size sets the size of the tools' state hash tables; 'auto'
+ * sizes each run from the stored states of a first, untimed run, as the GUI does.
+ * The report gives the resulting load factor (stored states per bucket).
+ * --block-size sets the allocation block size of the tools' pools the same way.
+ */
+
+const fs = require('fs')
+const os = require('os')
+const path = require('path')
+const { runTool, getBinDir } = require('../src/main/utils/tchecker')
+const { parseStats } = require('../src/main/utils/stats-parser')
+const { derivePerfMetrics } = require('../src/main/utils/perf-counters')
+const {
+  tableSizeFor,
+  blockSizeFor,
+  DEFAULT_TABLE_SIZE,
+  DEFAULT_BLOCK_SIZE
+} = require('../src/main/utils/search-sizing')
+const { SCALES } = require('./bench-models')
+
+const ALGORITHMS = {
+  reach: { tool: 'tck-reach', args: ['-a', 'reach'], labels: 'reachLabels' },
+  covreach: { tool: 'tck-reach', args: ['-a', 'covreach'], labels: 'reachLabels' },
+  ndfs: { tool: 'tck-liveness', args: ['-a', 'ndfs'], labels: 'livenessLabels' },
+  couvscc: { tool: 'tck-liveness', args: ['-a', 'couvscc'], labels: 'livenessLabels' }
+}
+
+function parseArgs(argv) {
+  const options = {
+    scale: 'small',
+    repeat: 3,
+    out: null,
+    baseline: null,
+    tolerance: 0.1,
+    algorithms: Object.keys(ALGORITHMS),
+    perf: false,
+    memoryBacking: { hugePages: false, numa: null },
+    tableSize: null,
+    blockSize: null
+  }
+
+  for (let i = 0; i < argv.length; i++) {
+    const value = argv[i + 1]
+    switch (argv[i]) {
+      case '--scale':
+        options.scale = value
+        i++
+        break
+      case '--repeat':
+        options.repeat = Math.max(1, parseInt(value))
+        i++
+        break
+      case '--out':
+        options.out = value
+        i++
+        break
+      case '--baseline':
+        options.baseline = value
+        i++
+        break
+      case '--tolerance':
+        options.tolerance = parseFloat(value)
+        i++
+        break
+      case '--algorithms':
+        options.algorithms = value.split(',')
+        i++
+        break
+      case '--perf':
+        options.perf = true
+        break
+      case '--hugepages':
+        options.memoryBacking.hugePages = true
+        break
+      case '--numa':
+        options.memoryBacking.numa = value
+        i++
+        break
+      case '--table-size':
+        options.tableSize = value === 'auto' ? 'auto' : parseInt(value)
+        i++
+        break
+      case '--block-size':
+        options.blockSize = value === 'auto' ? 'auto' : parseInt(value)
+        i++
+        break
+      default:
+        throw new Error(`Unknown option ${argv[i]}`)
+    }
+  }
+
+  if (!SCALES[options.scale]) throw new Error(`Unknown scale ${options.scale}`)
+  if (![null, 'interleave', 'local'].includes(options.memoryBacking.numa)) {
+    throw new Error(`Unknown NUMA policy ${options.memoryBacking.numa}`)
+  }
+  for (const algorithm of options.algorithms) {
+    if (!ALGORITHMS[algorithm]) throw new Error(`Unknown algorithm ${algorithm}`)
+  }
+  return options
+}
+
+function median(values) {
+  const sorted = [...values].sort((a, b) => a - b)
+  const mid = Math.floor(sorted.length / 2)
+  return sorted.length % 2 ? sorted[mid] : (sorted[mid - 1] + sorted[mid]) / 2
+}
+
+/**
+ * Per-field median of the counters of repeated runs
+ * @param {object[]} counters - perfCounters of each run, null when not counted
+ * @returns {object|null}
+ */
+function medianCounters(counters) {
+  const counted = counters.filter(Boolean)
+  if (counted.length === 0) return null
+  const result = {}
+  for (const field of Object.keys(counted[0])) {
+    const values = counted.map((c) => c[field]).filter((v) => v !== null)
+    result[field] = values.length > 0 ? median(values) : null
+  }
+  return result
+}
+
+function formatCount(value) {
+  return value === null ? '-' : value.toFixed(value < 10 ? 2 : 0)
+}
+
+/**
+ * Run one model with one algorithm
+ * @param {object} model - Generated model
+ * @param {string} modelFile - Path of the model file
+ * @param {string} algorithm - Key of ALGORITHMS
+ * @returns {Promise<object>} - Measurements of the run
+ */
+async function runOnce(model, modelFile, algorithm, options, sizes = {}) {
+  const { tool, args, labels } = ALGORITHMS[algorithm]
+  const sizeArgs = [
+    ...(sizes.tableSize ? ['--table-size', String(sizes.tableSize)] : []),
+    ...(sizes.blockSize ? ['--block-size', String(sizes.blockSize)] : [])
+  ]
+  const start = process.hrtime.bigint()
+  // No progress callback: sampling RSS (ps on macOS) would load the host during the
+  // timed run, and the tool reports its own peak as MEMORY_MAX_RSS
+  const toolArgs = [...args, ...sizeArgs, '-l', model[labels].join(','), modelFile]
+  const run = await runTool(tool, toolArgs, {
+    perfCounters: options.perf,
+    memoryBacking: options.memoryBacking
+  })
+  const wallSeconds = Number(process.hrtime.bigint() - start) / 1e9
+
+  if (run.exitCode !== 0) {
+    throw new Error(`${tool} failed on ${model.name} (exit ${run.exitCode}):\n${run.stderr}`)
+  }
+
+  const stats = parseStats(run.stdout)
+  const visitedStates = stats.VISITED_STATES ?? null
+  const runningTime = stats.RUNNING_TIME_SECONDS ?? wallSeconds
+  return {
+    wallSeconds,
+    runningTimeSeconds: stats.RUNNING_TIME_SECONDS ?? null,
+    maxRssBytes: stats.MEMORY_MAX_RSS ?? null,
+    visitedStates,
+    storedStates: stats.STORED_STATES ?? null,
+    visitedTransitions: stats.VISITED_TRANSITIONS ?? null,
+    statesPerSecond:
+      visitedStates !== null && runningTime > 0 ? visitedStates / runningTime : null,
+    perfCounters: run.perfCounters ? derivePerfMetrics(run.perfCounters, stats) : null,
+    stats
+  }
+}
+
+/**
+ * Run every model of the scale with every algorithm, `repeat` times each
+ * Wall time and throughput are the medians over the repetitions; RSS is the maximum.
+ */
+async function runBenchmarks(options) {
+  const workDir = fs.mkdtempSync(path.join(os.tmpdir(), 'tck-bench-'))
+  const results = []
+
+  try {
+    for (const model of SCALES[options.scale]) {
+      const modelFile = path.join(workDir, `${model.name}.tck`)
+      fs.writeFileSync(modelFile, model.tck)
+
+      for (const algorithm of options.algorithms) {
+        let { tableSize, blockSize } = options
+        if (tableSize === 'auto' || blockSize === 'auto') {
+          const probe = await runOnce(model, modelFile, algorithm, { ...options, perf: false })
+          if (tableSize === 'auto') tableSize = tableSizeFor(probe.storedStates || 0)
+          if (blockSize === 'auto') blockSize = blockSizeFor(probe.storedStates || 0)
+        }
+
+        const runs = []
+        for (let i = 0; i < options.repeat; i++) {
+          runs.push(await runOnce(model, modelFile, algorithm, options, { tableSize, blockSize }))
+        }
+        const buckets = tableSize || DEFAULT_TABLE_SIZE
+
+        const result = {
+          model: model.name,
+          algorithm,
+          repeat: options.repeat,
+          wallSeconds: median(runs.map((run) => run.wallSeconds)),
+          runningTimeSeconds:
+            runs[0].runningTimeSeconds === null
+              ? null
+              : median(runs.map((run) => run.runningTimeSeconds)),
+          maxRssBytes: Math.max(...runs.map((run) => run.maxRssBytes || 0)) || null,
+          visitedStates: runs[0].visitedStates,
+          storedStates: runs[0].storedStates,
+          visitedTransitions: runs[0].visitedTransitions,
+          tableSize: buckets,
+          blockSize: blockSize || DEFAULT_BLOCK_SIZE,
+          loadFactor: runs[0].storedStates === null ? null : runs[0].storedStates / buckets,
+          statesPerSecond:
+            runs[0].statesPerSecond === null
+              ? null
+              : median(runs.map((run) => run.statesPerSecond)),
+          perfCounters: medianCounters(runs.map((run) => run.perfCounters))
+        }
+        results.push(result)
+        console.error(
+          `${model.name.padEnd(32)} ${algorithm.padEnd(9)} ` +
+            `${result.wallSeconds.toFixed(3)}s  ` +
+            `${result.maxRssBytes ? (result.maxRssBytes / 1048576).toFixed(1) : '-'}MB  ` +
+            `${result.statesPerSecond ? Math.round(result.statesPerSecond) : '-'} states/s` +
+            (result.perfCounters?.ipc
+              ? `  IPC ${result.perfCounters.ipc.toFixed(2)}  ` +
+                `${formatCount(result.perfCounters.cacheMissesPerState)} cache-misses/state`
+              : '')
+        )
+      }
+    }
+  } finally {
+    fs.rmSync(workDir, { recursive: true, force: true })
+  }
+
+  return {
+    date: new Date().toISOString(),
+    host: {
+      platform: process.platform,
+      arch: process.arch,
+      cpus: os.cpus()[0]?.model || 'unknown',
+      totalMemoryBytes: os.totalmem()
+    },
+    binDir: getBinDir(),
+    scale: options.scale,
+    memoryBacking: options.memoryBacking,
+    results
+  }
+}
+
+/**
+ * Compare a report with a baseline
+ * A run regresses when its wall time or peak RSS grew by more than `tolerance`,
+ * or when it explored a different number of states (a behaviour change).
+ * @returns {object[]} - Regressions { model, algorithm, metric, baseline, current }
+ */
+function compareReports(report, baseline, tolerance) {
+  const keyOf = (result) => `${result.model}/${result.algorithm}`
+  const byKey = new Map(baseline.results.map((result) => [keyOf(result), result]))
+  const regressions = []
+
+  for (const result of report.results) {
+    const before = byKey.get(keyOf(result))
+    if (!before) continue
+
+    const flag = (metric) =>
+      regressions.push({
+        model: result.model,
+        algorithm: result.algorithm,
+        metric,
+        baseline: before[metric],
+        current: result[metric]
+      })
+
+    for (const metric of ['wallSeconds', 'maxRssBytes']) {
+      if (before[metric] && result[metric] > before[metric] * (1 + tolerance)) flag(metric)
+    }
+    if (before.visitedStates !== null && result.visitedStates !== before.visitedStates) {
+      flag('visitedStates')
+    }
+  }
+
+  return regressions
+}
+
+/**
+ * Wall time and dTLB misses of each run relative to a baseline with another memory backing
+ */
+function printSpeedups(report, baseline) {
+  const keyOf = (result) => `${result.model}/${result.algorithm}`
+  const byKey = new Map(baseline.results.map((result) => [keyOf(result), result]))
+  console.error(
+    `Memory backing ${JSON.stringify(baseline.memoryBacking || {})} -> ` +
+      JSON.stringify(report.memoryBacking)
+  )
+  for (const result of report.results) {
+    const before = byKey.get(keyOf(result))
+    if (!before) continue
+    const tlb = (r) => r.perfCounters?.dtlbMissesPerState ?? null
+    console.error(
+      `${result.model.padEnd(32)} ${result.algorithm.padEnd(9)} ` +
+        `speedup ${(before.wallSeconds / result.wallSeconds).toFixed(2)}x` +
+        (tlb(before) !== null && tlb(result) !== null
+          ? `  dTLB misses/state ${formatCount(tlb(before))} -> ${formatCount(tlb(result))}`
+          : '')
+    )
+  }
+}
+
+async function main() {
+  const options = parseArgs(process.argv.slice(2))
+  const report = await runBenchmarks(options)
+
+  const json = JSON.stringify(report, null, 2)
+  if (options.out) fs.writeFileSync(options.out, `${json}\n`)
+  else console.log(json)
+
+  if (options.baseline) {
+    const baseline = JSON.parse(fs.readFileSync(options.baseline, 'utf8'))
+    if (JSON.stringify(baseline.memoryBacking) !== JSON.stringify(report.memoryBacking)) {
+      printSpeedups(report, baseline)
+    }
+    const regressions = compareReports(report, baseline, options.tolerance)
+    for (const r of regressions) {
+      const change = r.baseline ? `${((r.current / r.baseline - 1) * 100).toFixed(1)}%` : 'n/a'
+      console.error(
+        `REGRESSION ${r.model} ${r.algorithm} ${r.metric}: ` +
+          `${r.baseline} -> ${r.current} (${change})`
+      )
+    }
+    if (regressions.length > 0) {
+      process.exitCode = 1
+    } else {
+      console.error(`No regression against ${options.baseline} (tolerance ${options.tolerance})`)
+    }
+  }
+}
+
+main().catch((error) => {
+  console.error(error.message)
+  process.exitCode = 2
+})
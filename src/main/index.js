@@ -7,8 +7,13 @@ import icon from '../../resources/icon.png?asset'
 // 立即注册IPC处理器
 console.log('=== Registering IPC Handlers ===')
 
+// Controllers of the running verifications, aborted by 'cancel-verification'
+const activeVerifications = new Set()
+
 // IPC handler for property verification
 ipcMain.handle('verify-property', async (event, verificationRequest) => {
+  const controller = new AbortController()
+  activeVerifications.add(controller)
   try {
     console.log('=== Received verify property request ===')
     console.log('Request:', JSON.stringify(verificationRequest, null, 2))
@@ -19,7 +24,14 @@ ipcMain.handle('verify-property', async (event, verificationRequest) => {
 
     const { verifyProperty } = require(verificationManagerPath)
 
-    const result = await verifyProperty(verificationRequest)
+    const result = await verifyProperty(verificationRequest, {
+      signal: controller.signal,
+      onProgress: (progress) =>
+        event.sender.send('verification-progress', {
+          propertyId: verificationRequest.property?.id,
+          ...progress
+        })
+    })
     console.log('Verification completed, result:', result)
     return result
   } catch (error) {
@@ -29,11 +41,112 @@ ipcMain.handle('verify-property', async (event, verificationRequest) => {
       success: false,
       error: error.message
     }
+  } finally {
+    activeVerifications.delete(controller)
   }
 })
 
 console.log('verify-property handler registered')
 
+// IPC handler for verifying all properties of a model in parallel
+ipcMain.handle('verify-properties', async (event, batchRequest) => {
+  const controller = new AbortController()
+  activeVerifications.add(controller)
+  try {
+    console.log('=== Received verify properties request ===')
+    console.log('Properties:', batchRequest.properties?.length || 0)
+
+    const appPath = app.getAppPath()
+    const verificationManagerPath = join(appPath, 'src/main/utils/verification-manager.js')
+    const { verifyProperties } = require(verificationManagerPath)
+
+    return await verifyProperties(batchRequest, {
+      signal: controller.signal,
+      onProgress: (progress) => event.sender.send('verification-progress', progress)
+    })
+  } catch (error) {
+    console.error('Verify properties error:', error)
+    return {
+      success: false,
+      error: error.message
+    }
+  } finally {
+    activeVerifications.delete(controller)
+  }
+})
+
+console.log('verify-properties handler registered')
+
+// IPC handler for swarm verification: diversified tck-reach searches, first answer wins
+ipcMain.handle('swarm-verify-property', async (event, swarmRequest) => {
+  const controller = new AbortController()
+  activeVerifications.add(controller)
+  try {
+    console.log('=== Received swarm verify request ===')
+    console.log('Workers:', swarmRequest.workers || 'default')
+
+    const appPath = app.getAppPath()
+    const swarmPath = join(appPath, 'src/main/utils/swarm.js')
+    const { swarmVerify } = require(swarmPath)
+
+    return await swarmVerify(swarmRequest, {
+      signal: controller.signal,
+      onProgress: (progress) => event.sender.send('verification-progress', progress)
+    })
+  } catch (error) {
+    console.error('Swarm verify error:', error)
+    return {
+      success: false,
+      error: error.message
+    }
+  } finally {
+    activeVerifications.delete(controller)
+  }
+})
+
+console.log('swarm-verify-property handler registered')
+
+// IPC handler for statistical estimation of the probability of reaching a label
+ipcMain.handle('estimate-probability', async (event, estimationRequest) => {
+  const controller = new AbortController()
+  activeVerifications.add(controller)
+  try {
+    console.log('=== Received estimate probability request ===')
+
+    const appPath = app.getAppPath()
+    const statisticalPath = join(appPath, 'src/main/utils/statistical.js')
+    const { estimateProbability } = require(statisticalPath)
+
+    return await estimateProbability(estimationRequest, {
+      signal: controller.signal,
+      onProgress: (progress) =>
+        event.sender.send('estimation-progress', {
+          propertyId: estimationRequest.property?.id,
+          ...progress
+        })
+    })
+  } catch (error) {
+    console.error('Estimate probability error:', error)
+    return {
+      success: false,
+      error: error.message
+    }
+  } finally {
+    activeVerifications.delete(controller)
+  }
+})
+
+console.log('estimate-probability handler registered')
+
+// IPC handler for cancelling the running verifications
+ipcMain.handle('cancel-verification', async () => {
+  console.log('=== Cancelling', activeVerifications.size, 'verification(s) ===')
+  for (const controller of activeVerifications) {
+    controller.abort()
+  }
+  return { success: true }
+})
+
 // IPC handler for saving model
 ipcMain.handle('save-model', async (event, modelData) => {
   try {
@@ -206,6 +319,17 @@ app.whenReady().then(() => {
   })
 })
 
+// Stop the persistent tck-simulate sessions before exiting
+app.on('will-quit', () => {
+  try {
+    const simulationManagerPath = join(app.getAppPath(), 'src/main/utils/simulation-manager.js')
+    const { closeAllSessions } = require(simulationManagerPath)
+    closeAllSessions()
+  } catch (error) {
+    console.error('Close simulation sessions error:', error)
+  }
+})
+
 // Quit when all windows are closed, except on macOS. There, it's common
 // for applications and their menu bar to stay active until the user quits
 // explicitly with Cmd + Q.
@@ -1,65 +1,188 @@
 /**
- * dot-parser.js (v2)
+ * dot-parser.js (v3)
  * * 一个将 tck-simulate 生成的 DOT 格式字符串解析为 JSON 对象的健壮工具。
+ * * 使用手写的单遍扫描器：按下标遍历输入，只为最终的 id、属性名和属性值切片，
+ * * 不再对整个文件运行多遍正则表达式。
  */
 
-/**
- * 将 DOT 图形字符串中的属性字符串 (例如 `key1="value1", key2="value2"`) 解析为对象。
- * @param {string} attrString - 包含属性的字符串。
- * @returns {object} - 包含属性的键值对对象。
- */
-function parseAttributes(attrString) {
-  const attributes = {}
-  const attrRegex = /(\w+)="([^"]*)"/g
-  let match
-  while ((match = attrRegex.exec(attrString)) !== null) {
-    attributes[match[1]] = match[2]
-  }
-  return attributes
+// DOT 语句关键字，其后的属性是默认样式而不是节点
+const DOT_KEYWORDS = new Set(['node', 'edge', 'graph', 'digraph', 'subgraph'])
+
+const CH_NEWLINE = 10
+const CH_QUOTE = 34
+const CH_COMMA = 44
+const CH_MINUS = 45
+const CH_SEMICOLON = 59
+const CH_EQUALS = 61
+const CH_GT = 62
+const CH_LBRACKET = 91
+const CH_BACKSLASH = 92
+const CH_RBRACKET = 93
+
+function isSpace(c) {
+  return c === 32 || c === 9 || c === 13
+}
+
+function isIdChar(c) {
+  return (
+    (c >= 48 && c <= 57) || // 0-9
+    (c >= 65 && c <= 90) || // A-Z
+    (c >= 97 && c <= 122) || // a-z
+    c === 95 // _
+  )
 }
 
 /**
- * 将 DOT 图形字符串解析为结构化的 JSON 对象。
- * @param {string} dotString - tck-simulate 生成的 DOT 格式内容。
- * @returns {object} - 代表状态图的 JSON 对象，包含节点和边。
+ * 扫描器状态：输入字符串与当前位置
  */
-function parseDot(dotString) {
-  const graph = { nodes: [], edges: [] }
+class Scanner {
+  constructor(input) {
+    this.input = input
+    this.pos = 0
+    this.length = input.length
+  }
+
+  peek() {
+    return this.pos < this.length ? this.input.charCodeAt(this.pos) : -1
+  }
+
+  // 跳过同一行内的空白
+  skipInlineSpace() {
+    while (this.pos < this.length && isSpace(this.input.charCodeAt(this.pos))) this.pos++
+  }
+
+  // 跳过包括换行在内的空白
+  skipSpace() {
+    while (this.pos < this.length) {
+      const c = this.input.charCodeAt(this.pos)
+      if (!isSpace(c) && c !== CH_NEWLINE) break
+      this.pos++
+    }
+  }
 
-  // 正则表达式，用于匹配节点行，例如: 0 [initial="true", ...]
-  const nodeRegex = /^\s*(\w+)\s*\[([^\]]+)\]/gm
+  // 跳到下一行开头
+  skipLine() {
+    const next = this.input.indexOf('\n', this.pos)
+    this.pos = next === -1 ? this.length : next + 1
+  }
 
-  // 正则表达式，用于匹配边行，例如: 0 -> 1 [vedge="<p1@a>"]
-  const edgeRegex = /^\s*(\w+)\s*->\s*(\w+)\s*\[([^\]]+)\]/gm
+  // 读取一个标识符或带引号的字符串，失败时返回 null
+  readId() {
+    if (this.peek() === CH_QUOTE) return this.readQuoted()
+    const start = this.pos
+    while (this.pos < this.length && isIdChar(this.input.charCodeAt(this.pos))) this.pos++
+    return this.pos > start ? this.input.slice(start, this.pos) : null
+  }
 
-  let match
+  // 读取带引号的字符串，支持 \" 转义
+  readQuoted() {
+    const start = this.pos + 1 // 跳过开头的引号
+    let end = this.input.indexOf('"', start)
+    let escaped = false
+    while (end !== -1 && this.input.charCodeAt(end - 1) === CH_BACKSLASH) {
+      escaped = true
+      end = this.input.indexOf('"', end + 1)
+    }
+    if (end === -1) end = this.length
+    this.pos = end + 1
+    const raw = this.input.slice(start, end)
+    return escaped ? raw.replace(/\\(.)/g, '$1') : raw
+  }
 
-  // 1. 解析所有节点
-  while ((match = nodeRegex.exec(dotString)) !== null) {
-    // 确保这不是一条边 (一个简单的启发式方法)
-    if (match[0].includes('->')) continue
+  /**
+   * 读取属性列表 [key1="value1", key2="value2"]，当前位置需指向 '['。
+   * 值中的 ']' 位于引号内时不会提前结束列表。
+   */
+  readAttributes() {
+    const attributes = {}
+    this.pos++ // '['
+    while (this.pos < this.length) {
+      this.skipSpace()
+      const c = this.peek()
+      if (c === CH_RBRACKET) {
+        this.pos++
+        break
+      }
+      if (c === CH_COMMA || c === CH_SEMICOLON) {
+        this.pos++
+        continue
+      }
 
-    const nodeId = match[1]
-    const attributesString = match[2]
-    const attributes = parseAttributes(attributesString)
+      const key = this.readId()
+      if (key === null) {
+        this.pos++ // 跳过无法识别的字符
+        continue
+      }
 
-    graph.nodes.push({ id: nodeId, attributes })
+      this.skipSpace()
+      if (this.peek() === CH_EQUALS) {
+        this.pos++
+        this.skipSpace()
+        const value = this.readId()
+        attributes[key] = value === null ? '' : value
+      } else {
+        attributes[key] = 'true'
+      }
+    }
+    return attributes
   }
+}
+
+/**
+ * 扫描一段由完整行组成的 DOT 文本，把节点和边追加到 graph 中。
+ * @param {object} graph - 目标图 { nodes, edges }。
+ * @param {string} dotString - DOT 文本。
+ */
+function scanInto(graph, dotString) {
+  const scanner = new Scanner(dotString)
+
+  while (scanner.pos < scanner.length) {
+    scanner.skipSpace()
+    const c = scanner.peek()
+    if (c === -1) break
+
+    // 图的开始/结束行 ('{', '}') 与注释行
+    if (!(isIdChar(c) || c === CH_QUOTE)) {
+      scanner.skipLine()
+      continue
+    }
+
+    const source = scanner.readId()
+    scanner.skipInlineSpace()
 
-  // 2. 解析所有边
-  while ((match = edgeRegex.exec(dotString)) !== null) {
-    const source = match[1]
-    const target = match[2]
-    const attributesString = match[3]
-    const attributes = parseAttributes(attributesString)
-
-    graph.edges.push({
-      source: source,
-      target: target,
-      attributes: attributes
-    })
+    // 边：source -> target [attrs]
+    if (scanner.peek() === CH_MINUS && dotString.charCodeAt(scanner.pos + 1) === CH_GT) {
+      scanner.pos += 2
+      scanner.skipInlineSpace()
+      const target = scanner.readId()
+      scanner.skipInlineSpace()
+      const attributes = scanner.peek() === CH_LBRACKET ? scanner.readAttributes() : {}
+      if (target !== null) {
+        graph.edges.push({ source, target, attributes })
+      }
+      scanner.skipLine()
+      continue
+    }
+
+    // 节点：id [attrs]，忽略 node/edge/graph 等默认样式语句
+    if (scanner.peek() === CH_LBRACKET) {
+      const attributes = scanner.readAttributes()
+      if (!DOT_KEYWORDS.has(source)) {
+        graph.nodes.push({ id: source, attributes })
+      }
+    }
+    scanner.skipLine()
   }
+}
 
+/**
+ * 将 DOT 图形字符串解析为结构化的 JSON 对象。
+ * @param {string} dotString - tck-simulate 生成的 DOT 格式内容。
+ * @returns {object} - 代表状态图的 JSON 对象，包含节点和边。
+ */
+function parseDot(dotString) {
+  const graph = { nodes: [], edges: [] }
+  scanInto(graph, dotString)
   return graph
 }
 
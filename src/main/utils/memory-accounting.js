@@ -0,0 +1,90 @@
+/**
+ * Memory Accounting
+ * Live bytes, peak bytes and object counts of the data the main process keeps
+ * between verifications: the model cache, the result store and the simulator
+ * sessions. The owners report every allocation and release, so peaks are exact
+ * rather than sampled. Together with the RSS of the tchecker processes this
+ * tells which component grows when the application runs out of memory.
+ *
+ * Sizes are the lengths of the strings held (UTF-16 code units), which is what
+ * these components are made of; object overhead is not counted.
+ */
+
+// component -> { liveBytes, peakBytes, count, peakCount }
+const components = new Map()
+
+function component(name) {
+  let entry = components.get(name)
+  if (!entry) {
+    entry = { liveBytes: 0, peakBytes: 0, count: 0, peakCount: 0 }
+    components.set(name, entry)
+  }
+  return entry
+}
+
+/**
+ * Record objects added to a component
+ * @param {string} name - Component name
+ * @param {number} bytes - Bytes added
+ * @param {number} [count] - Objects added
+ */
+function trackAllocation(name, bytes, count = 1) {
+  const entry = component(name)
+  entry.liveBytes += bytes
+  entry.count += count
+  entry.peakBytes = Math.max(entry.peakBytes, entry.liveBytes)
+  entry.peakCount = Math.max(entry.peakCount, entry.count)
+}
+
+/**
+ * Record objects removed from a component
+ * @param {string} name - Component name
+ * @param {number} bytes - Bytes released
+ * @param {number} [count] - Objects released
+ */
+function trackRelease(name, bytes, count = 1) {
+  const entry = component(name)
+  entry.liveBytes = Math.max(0, entry.liveBytes - bytes)
+  entry.count = Math.max(0, entry.count - count)
+}
+
+/**
+ * Current accounting of every component and of the main process
+ * @returns {object} - { components: [{ name, liveBytes, peakBytes, count, peakCount }],
+ *   heapUsedBytes, rssBytes }
+ */
+function memorySnapshot() {
+  const { heapUsed, rss } = process.memoryUsage()
+  return {
+    components: [...components].map(([name, entry]) => ({ name, ...entry })),
+    heapUsedBytes: heapUsed,
+    rssBytes: rss
+  }
+}
+
+/**
+ * Snapshot as a text table, largest component first
+ * @param {object} snapshot - Result of memorySnapshot
+ * @returns {string}
+ */
+function formatMemorySnapshot(snapshot) {
+  const mb = (bytes) => `${(bytes / 1048576).toFixed(2)}MB`
+  const lines = [...snapshot.components]
+    .sort((a, b) => b.liveBytes - a.liveBytes)
+    .map(
+      (c) =>
+        `${c.name.padEnd(20)} live ${mb(c.liveBytes).padStart(10)} ` +
+        `peak ${mb(c.peakBytes).padStart(10)}  objects ${c.count} (peak ${c.peakCount})`
+    )
+  lines.push(
+    `${'main process'.padEnd(20)} heap ${mb(snapshot.heapUsedBytes)}  rss ${mb(snapshot.rssBytes)}`
+  )
+  return lines.join('\n')
+}
+
+module.exports = {
+  trackAllocation,
+  trackRelease,
+  memorySnapshot,
+  formatMemorySnapshot
+}
@@ -0,0 +1,100 @@
+const fs = require('fs')
+const { spawnSync } = require('child_process')
+
+/**
+ * Memory Backing of Tool Processes
+ * tck-reach keeps its passed and waiting stores in malloc'd memory, so large
+ * searches spend much of their time in TLB misses and, on multi-socket hosts, in
+ * remote memory accesses. Both can be changed from outside the process:
+ * - hugePages: glibc malloc backs its heap with transparent huge pages
+ *   (GLIBC_TUNABLES=glibc.malloc.hugetlb=1, glibc 2.35+; ignored by older glibc)
+ * - numa 'interleave': pages spread round-robin over all nodes (numactl
+ *   --interleave=all), so one search is not limited to one node's bandwidth
+ * - numa 'local': each process prefers the memory of one node, with its threads
+ *   on that node; concurrent runs (swarm workers, batches) are spread over nodes
+ *
+ * Defaults come from TCHECKER_GUI_HUGEPAGES=1 and TCHECKER_GUI_NUMA=interleave|local.
+ * NUMA placement needs numactl and is skipped when it is missing.
+ */
+
+const NUMA_POLICIES = ['interleave', 'local']
+
+let numactlAvailable = null
+let nodeCount = null
+
+function hasNumactl() {
+  if (numactlAvailable === null) {
+    numactlAvailable =
+      process.platform === 'linux' && spawnSync('numactl', ['--show']).status === 0
+    if (!numactlAvailable) console.warn('numactl unavailable, NUMA placement disabled')
+  }
+  return numactlAvailable
+}
+
+/**
+ * Number of NUMA nodes of the host
+ * @returns {number} - At least 1
+ */
+function numaNodeCount() {
+  if (nodeCount === null) {
+    try {
+      nodeCount = fs
+        .readdirSync('/sys/devices/system/node')
+        .filter((name) => /^node\d+$/.test(name)).length
+    } catch (err) {
+      nodeCount = 0
+    }
+    nodeCount = Math.max(1, nodeCount)
+  }
+  return nodeCount
+}
+
+/**
+ * Memory backing requested through the environment
+ * @returns {object} - { hugePages, numa } with numa null, 'interleave' or 'local'
+ */
+function defaultMemoryBacking() {
+  const numa = process.env.TCHECKER_GUI_NUMA
+  return {
+    hugePages: process.env.TCHECKER_GUI_HUGEPAGES === '1',
+    numa: NUMA_POLICIES.includes(numa) ? numa : null
+  }
+}
+
+/**
+ * Command line and environment starting a program with the given memory backing
+ * @param {string} command - Program path
+ * @param {string[]} args - Program arguments
+ * @param {object} backing - { hugePages, numa, slot } where slot numbers concurrent
+ *   processes, so that 'local' places them on successive nodes
+ * @returns {object} - { command, args, env } (env undefined when unchanged)
+ */
+function applyMemoryBacking(command, args, backing) {
+  let env
+  if (backing.hugePages) {
+    const tunables = process.env.GLIBC_TUNABLES
+    env = {
+      ...process.env,
+      GLIBC_TUNABLES: `${tunables ? `${tunables}:` : ''}glibc.malloc.hugetlb=1`
+    }
+  }
+
+  if (!backing.numa || !hasNumactl()) {
+    return { command, args, env }
+  }
+
+  let policy
+  if (backing.numa === 'interleave') {
+    policy = ['--interleave=all']
+  } else {
+    const node = (backing.slot || 0) % numaNodeCount()
+    policy = [`--cpunodebind=${node}`, `--preferred=${node}`]
+  }
+  return { command: 'numactl', args: [...policy, '--', command, ...args], env }
+}
+
+module.exports = {
+  defaultMemoryBacking,
+  applyMemoryBacking,
+  numaNodeCount
+}
@@ -0,0 +1,125 @@
+const fs = require('fs').promises
+const os = require('os')
+const path = require('path')
+const crypto = require('crypto')
+const { generateTckFromJSON } = require('./tck-generator')
+const { trackAllocation, trackRelease } = require('./memory-accounting')
+
+/**
+ * Model Cache
+ * Content-addressed store of generated TCK files, so that repeated tool
+ * invocations on an unchanged model reuse one file instead of regenerating
+ * and rewriting it every time
+ */
+
+const CACHE_DIR = path.join(os.tmpdir(), 'tchecker-gui', 'models')
+const MAX_ENTRIES = 64
+
+// hash -> { hash, tckFile, tckContent }, kept in least-recently-used order
+const entries = new Map()
+// hash -> Promise of the entry, for models being written
+const pending = new Map()
+
+/**
+ * Compute the cache key of a TCK model
+ * @param {string} tckContent - TCK file content
+ * @returns {string} - Hex SHA-256 digest of the content
+ */
+function hashContent(tckContent) {
+  return crypto.createHash('sha256').update(tckContent).digest('hex')
+}
+
+/**
+ * Make sure the cached file for a hash exists and still holds the expected content
+ * @param {string} tckFile - Cache file path
+ * @param {string} tckContent - Expected content
+ * @param {string} hash - Expected content hash
+ */
+async function materialize(tckFile, tckContent, hash) {
+  try {
+    const existing = await fs.readFile(tckFile, 'utf8')
+    if (hashContent(existing) === hash) return
+    console.warn('Stale model cache entry, rewriting:', tckFile)
+  } catch (err) {
+    if (err.code !== 'ENOENT') throw err
+  }
+
+  // Write to a private file first so concurrent readers never see a partial model
+  const tempFile = `${tckFile}.${crypto.randomUUID()}.tmp`
+  await fs.writeFile(tempFile, tckContent, 'utf8')
+  await fs.rename(tempFile, tckFile)
+}
+
+/**
+ * Drop least-recently-used entries beyond the cache capacity
+ */
+async function evict() {
+  while (entries.size > MAX_ENTRIES) {
+    const [oldestHash, oldest] = entries.entries().next().value
+    entries.delete(oldestHash)
+    trackRelease('model-cache', oldest.tckContent.length)
+    try {
+      await fs.unlink(oldest.tckFile)
+    } catch (err) {
+      if (err.code !== 'ENOENT') {
+        console.error('Error evicting cached model:', err)
+      }
+    }
+  }
+}
+
+/**
+ * Write a model into the cache
+ * @param {string} hash - Content hash
+ * @param {string} tckContent - TCK file content
+ * @returns {Promise<object>} - { hash, tckFile, tckContent }
+ */
+async function insert(hash, tckContent) {
+  await fs.mkdir(CACHE_DIR, { recursive: true })
+  const tckFile = path.join(CACHE_DIR, `${hash}.tck`)
+  await materialize(tckFile, tckContent, hash)
+
+  const entry = { hash, tckFile, tckContent }
+  entries.set(hash, entry)
+  trackAllocation('model-cache', tckContent.length)
+  await evict()
+  return entry
+}
+
+/**
+ * Generate the TCK file for a model, reusing the cached file when the content is unchanged
+ * @param {object} modelJson - JSON model
+ * @returns {Promise<object>} - { hash, tckFile, tckContent }
+ */
+async function prepareModel(modelJson) {
+  const tckContent = generateTckFromJSON(modelJson)
+  const hash = hashContent(tckContent)
+
+  const cached = entries.get(hash)
+  if (cached) {
+    entries.delete(hash)
+    entries.set(hash, cached)
+    // The cache directory is shared between application instances, which evict
+    // each other's files
+    try {
+      await fs.stat(cached.tckFile)
+    } catch (err) {
+      if (err.code !== 'ENOENT') throw err
+      await materialize(cached.tckFile, tckContent, hash)
+    }
+    return cached
+  }
+
+  // Concurrent misses on the same model wait for a single write
+  let inserting = pending.get(hash)
+  if (!inserting) {
+    inserting = insert(hash, tckContent).finally(() => pending.delete(hash))
+    pending.set(hash, inserting)
+  }
+  return inserting
+}
+
+module.exports = {
+  prepareModel,
+  hashContent
+}
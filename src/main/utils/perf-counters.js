@@ -0,0 +1,147 @@
+const fs = require('fs')
+const os = require('os')
+const path = require('path')
+const { spawnSync } = require('child_process')
+
+/**
+ * Hardware Performance Counters
+ * Runs a tchecker tool under `perf stat` (Linux only) to count cycles,
+ * instructions, cache misses, branch misses and dTLB misses over the whole run,
+ * and relates them to the explored state space. A high miss count per state
+ * points at a memory-bound search (passed/waiting store), a high cycle count per
+ * state at a compute-bound one (zone operations).
+ *
+ * perf is optional: when it is missing or counters are not permitted, the run
+ * goes ahead unwrapped and no counters are reported.
+ */
+
+// perf event name -> result field
+const PERF_EVENTS = {
+  cycles: 'cycles',
+  instructions: 'instructions',
+  'cache-references': 'cacheReferences',
+  'cache-misses': 'cacheMisses',
+  'branch-misses': 'branchMisses',
+  'dTLB-load-misses': 'dtlbLoadMisses'
+}
+
+let available = null
+
+/**
+ * Whether `perf stat` can be used on this host
+ * @returns {boolean}
+ */
+function perfAvailable() {
+  if (available === null) {
+    if (process.platform !== 'linux') {
+      available = false
+    } else {
+      const probe = spawnSync('perf', ['stat', '-x', ',', '-e', 'instructions', 'true'], {
+        encoding: 'utf8'
+      })
+      available = probe.status === 0 && !/not supported|Permission/i.test(probe.stderr || '')
+      if (!available) console.warn('perf stat unavailable, hardware counters disabled')
+    }
+  }
+  return available
+}
+
+/**
+ * Command line running a program under perf stat, counters written to a file
+ * @param {string} command - Program path
+ * @param {string[]} args - Program arguments
+ * @returns {object} - { command, args, outputFile }
+ */
+function perfStatCommand(command, args) {
+  const outputFile = path.join(
+    os.tmpdir(),
+    `tchecker-perf-${process.pid}-${Date.now()}-${Math.random().toString(36).slice(2)}.csv`
+  )
+  return {
+    command: 'perf',
+    args: [
+      'stat',
+      '-x',
+      ',',
+      '-o',
+      outputFile,
+      '-e',
+      Object.keys(PERF_EVENTS).join(','),
+      '--',
+      command,
+      ...args
+    ],
+    outputFile
+  }
+}
+
+/**
+ * Parse `perf stat -x ,` output
+ * Lines are "value,unit,event,..."; uncounted events read "<not counted>" or
+ * "<not supported>" and are reported as null.
+ * @param {string} text - perf output file content
+ * @returns {object} - { cycles, instructions, cacheReferences, cacheMisses, branchMisses,
+ *   dtlbLoadMisses }
+ */
+function parsePerfStat(text) {
+  const counters = {}
+  for (const field of Object.values(PERF_EVENTS)) counters[field] = null
+
+  for (const line of text.split('\n')) {
+    if (!line || line.startsWith('#')) continue
+    const [value, , event] = line.split(',')
+    // Hybrid CPUs report events as cpu_core/cycles/ and cpu_atom/cycles/
+    const name = (event || '').replace(/^[a-z_]+\/(.*)\/[a-z]*$/, '$1')
+    const field = PERF_EVENTS[name]
+    const count = Number(value)
+    if (field && value !== '' && !Number.isNaN(count)) {
+      counters[field] = (counters[field] || 0) + count
+    }
+  }
+  return counters
+}
+
+/**
+ * Read and delete the counter file of a run
+ * @param {string} outputFile - File given to perf stat -o
+ * @returns {object|null} - Parsed counters, null when perf wrote nothing
+ */
+function readPerfStat(outputFile) {
+  try {
+    return parsePerfStat(fs.readFileSync(outputFile, 'utf8'))
+  } catch (err) {
+    if (err.code !== 'ENOENT') console.error('Error reading perf counters:', err)
+    return null
+  } finally {
+    fs.rmSync(outputFile, { force: true })
+  }
+}
+
+/**
+ * Metrics derived from the counters and the tool's statistics
+ * @param {object} counters - Parsed counters
+ * @param {object} stats - Statistics of the run (VISITED_STATES)
+ * @returns {object} - Counters plus ipc, cacheMissRate and per-visited-state figures
+ */
+function derivePerfMetrics(counters, stats = {}) {
+  const ratio = (a, b) => (a !== null && b ? a / b : null)
+  const states = stats.VISITED_STATES || 0
+  return {
+    ...counters,
+    ipc: ratio(counters.instructions, counters.cycles),
+    cacheMissRate: ratio(counters.cacheMisses, counters.cacheReferences),
+    cyclesPerState: ratio(counters.cycles, states),
+    instructionsPerState: ratio(counters.instructions, states),
+    cacheMissesPerState: ratio(counters.cacheMisses, states),
+    branchMissesPerState: ratio(counters.branchMisses, states),
+    dtlbMissesPerState: ratio(counters.dtlbLoadMisses, states)
+  }
+}
+
+module.exports = {
+  perfAvailable,
+  perfStatCommand,
+  parsePerfStat,
+  readPerfStat,
+  derivePerfMetrics
+}
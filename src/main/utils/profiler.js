@@ -0,0 +1,151 @@
+/**
+ * Phase Profiler
+ * Wall-clock timers and event counters for the phases of a verification: model
+ * generation, fingerprinting, the tck-reach run, certificate reading, statistics
+ * parsing and checkpointing. tck-reach itself only reports totals, so
+ * the breakdown tells whether a slow verification is spent in the search or
+ * around it.
+ *
+ * Disabled unless TCHECKER_GUI_PROFILE=1; a disabled profile calls the timed
+ * functions directly and records nothing.
+ */
+
+const ENABLED = process.env.TCHECKER_GUI_PROFILE === '1'
+
+class PhaseProfile {
+  constructor() {
+    // phase -> { nanoseconds, calls, counters }, in first-use order
+    this.phases = new Map()
+  }
+
+  phase(name) {
+    let phase = this.phases.get(name)
+    if (!phase) {
+      phase = { nanoseconds: 0n, calls: 0, counters: {} }
+      this.phases.set(name, phase)
+    }
+    return phase
+  }
+
+  /**
+   * Time a synchronous or asynchronous function as one call of a phase
+   * @param {string} name - Phase name
+   * @param {function} fn - Function to run
+   * @returns {*} - Return value of fn (a promise for async functions)
+   */
+  time(name, fn) {
+    const phase = this.phase(name)
+    const start = process.hrtime.bigint()
+    const stop = () => {
+      phase.nanoseconds += process.hrtime.bigint() - start
+      phase.calls++
+    }
+
+    let value
+    try {
+      value = fn()
+    } catch (error) {
+      stop()
+      throw error
+    }
+    if (value && typeof value.then === 'function') {
+      return value.finally(stop)
+    }
+    stop()
+    return value
+  }
+
+  /**
+   * Add to an event counter of a phase
+   * @param {string} name - Phase name
+   * @param {string} counter - Counter name (bytes, nodes, ...)
+   * @param {number} [amount] - Increment
+   */
+  count(name, counter, amount = 1) {
+    const { counters } = this.phase(name)
+    counters[counter] = (counters[counter] || 0) + amount
+  }
+
+  /**
+   * Attribute part of a phase to a sub-phase measured elsewhere
+   * Used to split the tck-reach run into the search time reported by the tool and
+   * the process overhead (start-up, model parsing, output) around it.
+   * @param {string} name - Phase the time is taken from
+   * @param {string} part - Sub-phase name
+   * @param {number} seconds - Time of the sub-phase
+   */
+  split(name, part, seconds) {
+    const phase = this.phases.get(name)
+    if (!phase || !(seconds > 0)) return
+    const nanoseconds = BigInt(Math.min(Math.round(seconds * 1e9), Number(phase.nanoseconds)))
+    const sub = this.phase(`${name}/${part}`)
+    sub.nanoseconds += nanoseconds
+    sub.calls++
+  }
+
+  /**
+   * @returns {object[]} - [{ phase, seconds, calls, ...counters }] in first-use order
+   */
+  toJSON() {
+    return [...this.phases].map(([name, phase]) => ({
+      phase: name,
+      seconds: Number(phase.nanoseconds) / 1e9,
+      calls: phase.calls,
+      ...phase.counters
+    }))
+  }
+
+  /**
+   * Phase breakdown as a text table, one phase per line with its share of the total
+   * Sub-phases (name/part) are indented under their phase and not added to the total.
+   */
+  format() {
+    const all = this.toJSON()
+    const rows = []
+    for (const row of all.filter((r) => !r.phase.includes('/'))) {
+      rows.push(row, ...all.filter((r) => r.phase.startsWith(`${row.phase}/`)))
+    }
+    const total = all
+      .filter((row) => !row.phase.includes('/'))
+      .reduce((sum, row) => sum + row.seconds, 0)
+    const lines = rows.map(({ phase, seconds, calls, ...counters }) => {
+      const name = phase.includes('/') ? `  ${phase.split('/').pop()}` : phase
+      const share = total > 0 ? ((seconds / total) * 100).toFixed(1) : '0.0'
+      const extra = Object.entries(counters)
+        .map(([counter, value]) => `${counter}=${value}`)
+        .join(' ')
+      return (
+        `${name.padEnd(20)} ${(seconds * 1000).toFixed(2).padStart(10)}ms ` +
+        `${share.padStart(5)}%  x${calls}${extra ? `  ${extra}` : ''}`
+      )
+    })
+    lines.push(`${'total'.padEnd(20)} ${(total * 1000).toFixed(2).padStart(10)}ms`)
+    return lines.join('\n')
+  }
+}
+
+// Shared by every verification when profiling is off
+const DISABLED_PROFILE = {
+  enabled: false,
+  time: (name, fn) => fn(),
+  count: () => {},
+  split: () => {},
+  toJSON: () => null,
+  format: () => ''
+}
+
+/**
+ * Profile for one verification
+ * @returns {object} - PhaseProfile, or a no-op profile when TCHECKER_GUI_PROFILE is not 1
+ */
+function createProfile() {
+  if (!ENABLED) return DISABLED_PROFILE
+  const profile = new PhaseProfile()
+  profile.enabled = true
+  return profile
+}
+
+module.exports = {
+  createProfile,
+  PhaseProfile
+}
@@ -0,0 +1,78 @@
+const { hashContent } = require('./model-cache')
+const { toolIdentity } = require('./tchecker')
+
+/**
+ * Property Fingerprint
+ * Hash of the part of a model a property's verdict depends on. Two models with the
+ * same fingerprint for a property give the same tck-reach verdict for it, so a
+ * verdict computed before an edit can be reused when the edit left the fingerprint
+ * unchanged.
+ *
+ * Location labels are the only declarations tck-reach reads per property: they are
+ * matched against -l and otherwise ignored by the search. The fingerprint therefore
+ * hashes the TCK model with every label other than the property's target removed
+ * (all of them for deadlock freedom, which runs without -l). Any other edit, e.g. a
+ * guard, invariant or variable bound, changes the fingerprint and forces a new run.
+ * So does replacing tck-reach (another TCHECKER_BIN_DIR or a rebuilt binary), since a
+ * verdict is only as good as the checker that produced it.
+ */
+
+// Location declaration ending in a labels attribute, e.g. location:P:l0{initial::labels:a,b}
+const LOCATION_LABELS = /^(location:[^{]*)\{(.*?)labels:([^:}]*)\}$/
+
+/**
+ * Keep only the given label in a location declaration
+ * @param {string[]} match - Match of LOCATION_LABELS on the declaration
+ * @param {string|null} keep - Label to keep, null to drop all
+ * @returns {string} - Rewritten line
+ */
+function filterLabels(match, keep) {
+  // `before` holds the preceding attributes, each followed by the ':' separator
+  const [, declaration, before, labels] = match
+  if (keep && labels.split(',').some((label) => label.trim() === keep)) {
+    return `${declaration}{${before}labels:${keep}}`
+  }
+  return `${declaration}{${before.slice(0, -1)}}`
+}
+
+/**
+ * Fingerprints of a model for a batch of properties
+ * The model is split and its labelled locations are found once for the whole
+ * batch, and properties keeping the same label (e.g. reachability and safety of
+ * one label) share a single hash.
+ * @param {string} tckContent - Generated TCK model
+ * @param {object[]} properties - Property configurations
+ * @returns {string[]} - Hex digests, in the order of the properties
+ */
+function propertyFingerprints(tckContent, properties) {
+  const lines = tckContent.split('\n').filter((line) => line && !line.startsWith('#'))
+  const matches = lines.map((line) => line.match(LOCATION_LABELS))
+  const tool = toolIdentity('tck-reach')
+  const byLabel = new Map()
+
+  return properties.map((property) => {
+    const keep = property.type === 'deadlock-free' ? null : property.targetLabel || null
+    let fingerprint = byLabel.get(keep)
+    if (fingerprint === undefined) {
+      const relevant = lines.map((line, i) => (matches[i] ? filterLabels(matches[i], keep) : line))
+      fingerprint = hashContent(`${tool}\n${relevant.join('\n')}`)
+      byLabel.set(keep, fingerprint)
+    }
+    return fingerprint
+  })
+}
+
+/**
+ * Fingerprint of a model with respect to one property
+ * @param {string} tckContent - Generated TCK model
+ * @param {object} property - Property configuration
+ * @returns {string} - Hex digest
+ */
+function propertyFingerprint(tckContent, property) {
+  return propertyFingerprints(tckContent, [property])[0]
+}
+
+module.exports = {
+  propertyFingerprint,
+  propertyFingerprints
+}
@@ -0,0 +1,40 @@
+/**
+ * Seeded Random Numbers
+ * Small deterministic generators for the parts of the application that must be
+ * reproducible from a seed: swarm model variants and statistical random runs.
+ */
+
+/**
+ * Small seeded PRNG (mulberry32)
+ * @param {number} seed - 32-bit seed
+ * @returns {function} - () => number in [0, 1)
+ */
+function seededRandom(seed) {
+  let state = seed >>> 0
+  return () => {
+    state = (state + 0x6d2b79f5) >>> 0
+    let t = state
+    t = Math.imul(t ^ (t >>> 15), t | 1)
+    t ^= t + Math.imul(t ^ (t >>> 7), t | 61)
+    return ((t ^ (t >>> 14)) >>> 0) / 4294967296
+  }
+}
+
+/**
+ * Seed of an independent stream derived from a base seed (murmur3 finalizer), so
+ * that neighbouring streams of neighbouring seeds do not overlap
+ * @param {number} seed - Base seed
+ * @param {number} stream - Stream number, e.g. a worker index
+ * @returns {number} - 32-bit seed
+ */
+function deriveSeed(seed, stream) {
+  let h = (seed ^ Math.imul(stream + 1, 0x9e3779b9)) >>> 0
+  h = Math.imul(h ^ (h >>> 16), 0x85ebca6b)
+  h = Math.imul(h ^ (h >>> 13), 0xc2b2ae35)
+  return (h ^ (h >>> 16)) >>> 0
+}
+
+module.exports = {
+  seededRandom,
+  deriveSeed
+}
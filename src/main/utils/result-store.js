@@ -0,0 +1,253 @@
+const fs = require('fs').promises
+const os = require('os')
+const path = require('path')
+const crypto = require('crypto')
+const { trackAllocation, trackRelease } = require('./memory-accounting')
+
+/**
+ * Result Store
+ * Append-only checkpoint of finished verifications, so that a batch interrupted
+ * by a crash, an out-of-memory kill or a reboot resumes with the properties that
+ * were still open instead of starting over.
+ *
+ * Each line of the store file is one JSON record { key, time, result }. Records
+ * are only ever appended; on load the last record of a key wins, and the file is
+ * rewritten without superseded records once they make up most of it.
+ *
+ * A stored result only keeps what the verdict views cannot rebuild: verdict,
+ * statistics and the DOT certificate. Certificates over MAX_STORED_GRAPH_BYTES, and
+ * those already cut when read, are kept as a preview marked with the full size, so
+ * a reused verdict shows the same notice as a fresh run with a large certificate.
+ * The store holds at most MAX_RECORDS records and MAX_STORE_BYTES bytes, the
+ * oldest records going first.
+ */
+
+const STORE_DIR = process.env.TCHECKER_GUI_DATA_DIR || path.join(os.homedir(), '.tchecker-gui')
+const STORE_FILE = path.join(STORE_DIR, 'results.jsonl')
+
+// Compact when the file holds this many times more lines than live records
+const COMPACT_RATIO = 2
+const COMPACT_MIN_LINES = 100
+
+const MAX_RECORDS = 2000
+const MAX_STORE_BYTES = 32 * 1024 * 1024
+// Larger certificates are stored as their beginning only
+const MAX_STORED_GRAPH_BYTES = 1024 * 1024
+
+// key -> stored result, loaded from the file on first use
+let records = null
+let loading = null
+let lineCount = 0
+// Appends and compactions of the store file, run one at a time
+let writes = Promise.resolve()
+let compactionSeq = 0
+// key -> serialized size of the stored result, for memory accounting
+const recordSizes = new Map()
+let storeBytes = 0
+
+/**
+ * Part of a verification result that is stored
+ * @param {object} result - Result of verifyProperty (or a record of an older store)
+ * @returns {object} - { verdict, satisfied, stats, dotGraph } with the complete certificate,
+ *   or { verdict, satisfied, stats, dotGraph: '', certificatePreview, certificateBytes }
+ */
+function storedResult(result) {
+  const stored = {
+    verdict: result.verdict,
+    satisfied: result.satisfied,
+    stats: result.stats || {},
+    dotGraph: ''
+  }
+  // A preview: from an older record, or the text read from a certificate too large to load
+  const preview =
+    result.certificatePreview ?? (result.certificateTruncated ? result.certificateOutput : '')
+  const dotGraph = result.dotGraph || ''
+  if (!preview && dotGraph.length <= MAX_STORED_GRAPH_BYTES) {
+    stored.dotGraph = dotGraph
+    return stored
+  }
+
+  // Cut after the last complete line that fits
+  let text = preview || dotGraph
+  if (text.length > MAX_STORED_GRAPH_BYTES) {
+    const end = text.lastIndexOf('\n', MAX_STORED_GRAPH_BYTES - 1)
+    text = text.slice(0, end === -1 ? MAX_STORED_GRAPH_BYTES : end + 1)
+  }
+  stored.certificatePreview = text
+  stored.certificateBytes = result.certificateBytes || dotGraph.length
+  return stored
+}
+
+function deleteRecord(key) {
+  const bytes = recordSizes.get(key)
+  if (bytes === undefined) return
+  trackRelease('result-store', bytes)
+  storeBytes -= bytes
+  recordSizes.delete(key)
+  records.delete(key)
+}
+
+/**
+ * Keep a record in memory, replacing an earlier record of the same key and
+ * dropping the oldest records beyond the store capacity
+ */
+function setRecord(key, result, bytes) {
+  deleteRecord(key)
+  trackAllocation('result-store', bytes)
+  storeBytes += bytes
+  recordSizes.set(key, bytes)
+  records.set(key, result)
+
+  while (records.size > MAX_RECORDS || (storeBytes > MAX_STORE_BYTES && records.size > 1)) {
+    deleteRecord(records.keys().next().value)
+  }
+}
+
+/**
+ * Key of a property verdict on a given model
+ * Only the fields that decide the verdict take part: budgets only matter for
+ * 'unknown' verdicts, which are never stored.
+ * @param {string} modelKey - Property fingerprint of the generated TCK model
+ * @param {object} property - Property configuration
+ * @returns {string} - Store key
+ */
+function resultKey(modelKey, property) {
+  const propertyHash = crypto
+    .createHash('sha256')
+    .update(JSON.stringify([property.type, property.targetLabel || '']))
+    .digest('hex')
+  return `${modelKey}:${propertyHash}`
+}
+
+/**
+ * Read the store file into memory, skipping a torn last line left by a crash
+ */
+async function load() {
+  records = new Map()
+  lineCount = 0
+
+  let text = ''
+  try {
+    text = await fs.readFile(STORE_FILE, 'utf8')
+  } catch (err) {
+    if (err.code !== 'ENOENT') console.error('Error reading result store:', err)
+    return
+  }
+
+  for (const line of text.split('\n')) {
+    if (!line) continue
+    lineCount++
+    try {
+      const record = JSON.parse(line)
+      const result = storedResult(record.result)
+      setRecord(record.key, result, JSON.stringify(result).length)
+    } catch (err) {
+      console.warn('Skipping unreadable result store record:', err.message)
+    }
+  }
+
+  await compactIfSparse()
+}
+
+/**
+ * Compact the store file once superseded and evicted records make up most of it
+ */
+async function compactIfSparse() {
+  if (lineCount >= COMPACT_MIN_LINES && lineCount > records.size * COMPACT_RATIO) {
+    await compact()
+  }
+}
+
+/**
+ * Rewrite the store file with one record per key
+ */
+async function compact() {
+  const time = Date.now()
+  const lines = []
+  for (const [key, result] of records) {
+    lines.push(JSON.stringify({ key, time, result }))
+  }
+
+  const tempFile = `${STORE_FILE}.${process.pid}.${++compactionSeq}.tmp`
+  await fs.writeFile(tempFile, lines.length ? `${lines.join('\n')}\n` : '', 'utf8')
+  await fs.rename(tempFile, STORE_FILE)
+  lineCount = lines.length
+}
+
+/**
+ * Run a file operation after the ones already queued, so that a compaction never
+ * replaces the file while a record is being appended to it
+ * @param {function} task - Async task
+ * @returns {Promise} - Result of the task
+ */
+function serialize(task) {
+  const run = writes.then(task, task)
+  writes = run.catch(() => {})
+  return run
+}
+
+async function ensureLoaded() {
+  if (records) return
+  if (!loading) loading = load().finally(() => (loading = null))
+  await loading
+}
+
+/**
+ * Checkpoint a finished verification
+ * Only definitive verdicts are stored: failed, cancelled and budget-exhausted runs,
+ * and runs that crashed, were killed or did not report REACHABLE, are skipped.
+ * @param {string} modelKey - Property fingerprint of the generated TCK model
+ * @param {object} property - Property configuration
+ * @param {object} result - Result of verifyProperty
+ */
+async function recordResult(modelKey, property, result) {
+  const { exitCode, signal } = result.rawOutput || {}
+  const definitive = exitCode === 0 && !signal && typeof result.stats?.REACHABLE === 'boolean'
+  if (!result.success || result.verdict === 'unknown' || !definitive) return
+
+  try {
+    await ensureLoaded()
+    const key = resultKey(modelKey, property)
+    const stored = storedResult(result)
+
+    await serialize(async () => {
+      await fs.mkdir(STORE_DIR, { recursive: true })
+      const line = JSON.stringify({ key, time: Date.now(), result: stored })
+      await fs.appendFile(STORE_FILE, `${line}\n`)
+      setRecord(key, stored, JSON.stringify(stored).length)
+      lineCount++
+      await compactIfSparse()
+    })
+  } catch (err) {
+    console.error('Error writing result store:', err)
+  }
+}
+
+/**
+ * Result of an earlier run of the same property on an equivalent model
+ * @param {string} modelKey - Property fingerprint of the generated TCK model
+ * @param {object} property - Property configuration
+ * @returns {Promise<object|null>} - Stored { verdict, satisfied, stats, dotGraph }, or null
+ */
+async function lookupResult(modelKey, property) {
+  return (await lookupResults([modelKey], [property]))[0]
+}
+
+/**
+ * Stored results of a batch of properties, with one load of the store
+ * @param {string[]} modelKeys - Property fingerprints, one per property
+ * @param {object[]} properties - Property configurations
+ * @returns {Promise<Array<object|null>>} - Stored results, or null
+ */
+async function lookupResults(modelKeys, properties) {
+  await ensureLoaded()
+  return properties.map((property, index) => {
+    return records.get(resultKey(modelKeys[index], property)) || null
+  })
+}
+
+module.exports = {
+  recordResult,
+  lookupResult,
+  lookupResults
+}
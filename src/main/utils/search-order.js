@@ -0,0 +1,123 @@
+/**
+ * Search Order Selection
+ * Chooses the tck-reach search order (-s bfs|dfs) for a property. The 'auto' order
+ * uses a static estimate of how deep the target lies: for each process, the
+ * distance in its location graph from the initial location to the nearest
+ * location carrying the target label. Every trace to the target takes at least
+ * that many steps of the process, so it is a lower bound on the target depth.
+ * Breadth-first search pays for every interleaving up to that depth, while
+ * depth-first search reaches deep targets early at the price of longer traces.
+ */
+
+const SEARCH_ORDERS = ['bfs', 'dfs', 'auto']
+
+// Targets at least this many steps away are searched depth-first by 'auto'
+const AUTO_DFS_MIN_DEPTH = 4
+
+/**
+ * Location graphs of the processes of a generated TCK model
+ * @param {string} tckContent - Generated TCK model
+ * @returns {Map<string, object>} - Process name -> { initial, labels, predecessors }
+ */
+function processGraphs(tckContent) {
+  const graphs = new Map()
+  const graphOf = (proc) => {
+    let graph = graphs.get(proc)
+    if (!graph) {
+      graph = { initial: [], labels: new Map(), predecessors: new Map() }
+      graphs.set(proc, graph)
+    }
+    return graph
+  }
+
+  for (const line of tckContent.split('\n')) {
+    const brace = line.indexOf('{')
+    if (brace === -1) continue
+    const fields = line.slice(0, brace).split(':')
+    const attributes = line.slice(brace + 1, line.lastIndexOf('}'))
+
+    if (fields[0] === 'location' && fields.length === 3) {
+      const graph = graphOf(fields[1])
+      if (/(^|:)initial:/.test(attributes)) graph.initial.push(fields[2])
+      const labels = attributes.match(/(?:^|:)labels:([^:]*)$/)
+      graph.labels.set(fields[2], labels ? labels[1].split(',').map((l) => l.trim()) : [])
+    } else if (fields[0] === 'edge' && fields.length === 5) {
+      const { predecessors } = graphOf(fields[1])
+      const [, , source, target] = fields
+      if (!predecessors.has(target)) predecessors.set(target, [])
+      predecessors.get(target).push(source)
+    }
+  }
+
+  return graphs
+}
+
+/**
+ * Lower bound on the number of steps needed to reach a location labelled `label`
+ * @param {string} tckContent - Generated TCK model
+ * @param {string} label - Target label
+ * @returns {number|null} - Smallest per-process distance, null if no process can reach the label
+ */
+function targetDistance(tckContent, label) {
+  let best = null
+
+  for (const graph of processGraphs(tckContent).values()) {
+    // Backward BFS from the labelled locations
+    const distance = new Map()
+    let frontier = []
+    for (const [location, labels] of graph.labels) {
+      if (labels.includes(label)) {
+        distance.set(location, 0)
+        frontier.push(location)
+      }
+    }
+    while (frontier.length > 0) {
+      const next = []
+      for (const location of frontier) {
+        for (const source of graph.predecessors.get(location) || []) {
+          if (!distance.has(source)) {
+            distance.set(source, distance.get(location) + 1)
+            next.push(source)
+          }
+        }
+      }
+      frontier = next
+    }
+
+    for (const initial of graph.initial) {
+      if (distance.has(initial) && (best === null || distance.get(initial) < best)) {
+        best = distance.get(initial)
+      }
+    }
+  }
+
+  return best
+}
+
+/**
+ * Resolve the search order of a property
+ * @param {object} property - Property configuration (searchOrder: 'bfs' | 'dfs' | 'auto')
+ * @param {string} tckContent - Generated TCK model
+ * @returns {object} - { searchOrder: 'bfs' | 'dfs', targetDistance } (distance only for 'auto')
+ */
+function selectSearchOrder(property, tckContent) {
+  const requested = SEARCH_ORDERS.includes(property.searchOrder) ? property.searchOrder : 'bfs'
+  if (requested !== 'auto') {
+    return { searchOrder: requested, targetDistance: null }
+  }
+
+  // Deadlocks have no target to estimate a depth for
+  if (property.type === 'deadlock-free' || !property.targetLabel) {
+    return { searchOrder: 'bfs', targetDistance: null }
+  }
+
+  const distance = targetDistance(tckContent, property.targetLabel)
+  const deep = distance !== null && distance >= AUTO_DFS_MIN_DEPTH
+  return { searchOrder: deep ? 'dfs' : 'bfs', targetDistance: distance }
+}
+
+module.exports = {
+  selectSearchOrder,
+  targetDistance,
+  processGraphs
+}
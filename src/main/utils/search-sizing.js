@@ -0,0 +1,99 @@
+/**
+ * Search Sizing
+ * tck-reach keeps its passed states in a hash table with a fixed number of
+ * buckets (--table-size, 65536 by default). The table is not resized during the
+ * search, so a search storing millions of states walks long bucket chains on
+ * every lookup, while a tiny search pays for clearing buckets it never uses.
+ * States, zones and transitions come from pools that grow by blocks of
+ * --block-size objects (10000 by default); a search storing millions of states
+ * makes hundreds of block allocations per pool, each of them touching fresh
+ * pages in the middle of successor computation.
+ *
+ * The number of states a property stores does not change between runs of the same
+ * model, so each run is sized from the STORED_STATES of the previous run with the
+ * same property fingerprint (the model content the property depends on, see
+ * property-fingerprint.js) and algorithm: the table gets the smallest power of two
+ * keeping the load factor at most MAX_LOAD_FACTOR, and pools get blocks large enough
+ * to hold the states in about TARGET_BLOCKS blocks. The first run of a property on
+ * a model uses the tool defaults.
+ */
+
+const DEFAULT_TABLE_SIZE = 65536
+const MIN_TABLE_SIZE = 1024
+const MAX_TABLE_SIZE = 1 << 26
+const MAX_LOAD_FACTOR = 1
+
+const DEFAULT_BLOCK_SIZE = 10000
+const MIN_BLOCK_SIZE = 1024
+const MAX_BLOCK_SIZE = 1 << 20
+const TARGET_BLOCKS = 64
+
+// property fingerprint/algorithm -> statistics of the last completed run
+const history = new Map()
+
+function historyKey(fingerprint, algorithm) {
+  return `${fingerprint}:${algorithm}`
+}
+
+/**
+ * Hash table size for a number of stored states
+ * @param {number} storedStates - Expected number of stored states
+ * @returns {number} - Power of two between MIN_TABLE_SIZE and MAX_TABLE_SIZE
+ */
+function tableSizeFor(storedStates) {
+  let size = MIN_TABLE_SIZE
+  while (size < MAX_TABLE_SIZE && size * MAX_LOAD_FACTOR < storedStates) size *= 2
+  return size
+}
+
+/**
+ * Pool block size for a number of stored states
+ * @param {number} storedStates - Expected number of stored states
+ * @returns {number} - Power of two between MIN_BLOCK_SIZE and MAX_BLOCK_SIZE
+ */
+function blockSizeFor(storedStates) {
+  let size = MIN_BLOCK_SIZE
+  while (size < MAX_BLOCK_SIZE && size * TARGET_BLOCKS < storedStates) size *= 2
+  return size
+}
+
+/**
+ * Sizing of a tck-reach run
+ * @param {string} fingerprint - Property fingerprint of the model
+ * @param {string} algorithm - tck-reach algorithm
+ * @returns {object} - { tableSize, blockSize, expectedStates, args } where args are
+ *   the options to pass (empty when the tool defaults fit)
+ */
+function searchSizing(fingerprint, algorithm) {
+  const previous = history.get(historyKey(fingerprint, algorithm))
+  const expectedStates = previous?.STORED_STATES ?? null
+  const tableSize = expectedStates === null ? DEFAULT_TABLE_SIZE : tableSizeFor(expectedStates)
+  const blockSize = expectedStates === null ? DEFAULT_BLOCK_SIZE : blockSizeFor(expectedStates)
+
+  const args = []
+  if (tableSize !== DEFAULT_TABLE_SIZE) args.push('--table-size', String(tableSize))
+  if (blockSize !== DEFAULT_BLOCK_SIZE) args.push('--block-size', String(blockSize))
+  return { tableSize, blockSize, expectedStates, args }
+}
+
+/**
+ * Remember the statistics of a completed run for sizing the next one
+ * @param {string} fingerprint - Property fingerprint of the model
+ * @param {string} algorithm - tck-reach algorithm
+ * @param {object} stats - Parsed statistics (STORED_STATES)
+ */
+function recordSearchStats(fingerprint, algorithm, stats) {
+  if (typeof stats.STORED_STATES !== 'number') return
+  history.set(historyKey(fingerprint, algorithm), {
+    STORED_STATES: stats.STORED_STATES
+  })
+}
+
+module.exports = {
+  searchSizing,
+  recordSearchStats,
+  tableSizeFor,
+  blockSizeFor,
+  DEFAULT_TABLE_SIZE,
+  DEFAULT_BLOCK_SIZE
+}
@@ -0,0 +1,357 @@
+const { spawn } = require('child_process')
+const { trackAllocation, trackRelease } = require('./memory-accounting')
+
+/**
+ * Simulation Session
+ * Drives one persistent `tck-simulate -i` process over stdin/stdout. Each GUI step
+ * costs one successor computation in the running simulator instead of a fresh
+ * parse plus a batch of random steps.
+ *
+ * Protocol of tck-simulate's interactive mode: it prints a screen (the initial
+ * states, or the current state and its successors as numbered entries), then the
+ * prompt "Select 0-N (q: quit, r: random)? " and reads the chosen index from stdin.
+ * It exits when the current state has no successor.
+ */
+
+const PROMPT_MARKER = '(q: quit, r: random)?'
+const SCREEN_TIMEOUT_MS = 30000
+
+// Attributes printed for a transition; all others belong to the state
+const TRANSITION_ATTRIBUTES = new Set(['vedge', 'guard', 'reset', 'src_invariant', 'tgt_invariant'])
+
+/**
+ * Parse one attribute line, either `key: value`, `key=value` or `k1="v1", k2="v2"`
+ * @param {string} line - Output line
+ * @param {object} attributes - Attributes to fill
+ */
+function parseAttributeLine(line, attributes) {
+  const trimmed = line.trim()
+  if (!trimmed) return
+
+  if (trimmed.includes('="')) {
+    for (const match of trimmed.matchAll(/(\w+)="([^"]*)"/g)) {
+      attributes[match[1]] = match[2]
+    }
+    return
+  }
+
+  const match = trimmed.match(/^(\w+)\s*[:=]\s*(.*)$/)
+  if (match) {
+    attributes[match[1]] = match[2].trim()
+  }
+}
+
+/**
+ * Initial state or successor listed on a screen
+ * The attributes (transition and target state) are parsed on first access. Random
+ * runs and path replays only use the indices, so most entries are never
+ * materialized; the GUI reads them for the state it displays.
+ */
+class ScreenEntry {
+  constructor(index, line) {
+    this.index = index
+    this.lines = [line]
+    this.parsed = null
+  }
+
+  get attributes() {
+    if (!this.parsed) {
+      this.parsed = {}
+      for (const line of this.lines) parseAttributeLine(line, this.parsed)
+      this.lines = null
+    }
+    return this.parsed
+  }
+}
+
+/**
+ * Parse a screen printed by tck-simulate between two prompts
+ * @param {string} text - Screen text
+ * @returns {object} - { initial, current, successors } (null when the section is absent);
+ *   list entries are ScreenEntry objects with lazily parsed attributes
+ */
+function parseScreen(text) {
+  const screen = { initial: null, current: null, successors: null }
+  let list = null
+  let target = null // attributes of the current state
+  let entry = null // list entry being read
+
+  for (const line of text.split('\n')) {
+    if (line.startsWith('--- Initial states')) {
+      list = screen.initial = []
+      target = entry = null
+    } else if (line.startsWith('--- Current state')) {
+      list = entry = null
+      target = screen.current = {}
+    } else if (line.startsWith('--- Successors')) {
+      list = screen.successors = []
+      target = entry = null
+    } else {
+      const match = list && line.match(/^\s*(\d+)\)\s?(.*)$/)
+      if (match) {
+        entry = new ScreenEntry(parseInt(match[1]), match[2])
+        list.push(entry)
+      } else if (entry) {
+        entry.lines.push(line)
+      } else if (target) {
+        parseAttributeLine(line, target)
+      }
+    }
+  }
+
+  return screen
+}
+
+/**
+ * Split the attributes of a list entry into transition and state attributes
+ * @param {object} attributes - Entry attributes
+ * @returns {object} - { transition, state }
+ */
+function splitEntry(attributes) {
+  const transition = {}
+  const state = {}
+  for (const key in attributes) {
+    if (TRANSITION_ATTRIBUTES.has(key)) transition[key] = attributes[key]
+    else state[key] = attributes[key]
+  }
+  return { transition, state }
+}
+
+class SimulationSession {
+  /**
+   * @param {string} command - Path to the tck-simulate binary
+   * @param {string} tckFile - Model file
+   */
+  constructor(command, tckFile) {
+    this.command = command
+    this.tckFile = tckFile
+    this.child = null
+    this.buffer = ''
+    this.stderr = ''
+    this.waiter = null
+    this.exited = true
+    this.path = [] // choices made since the initial screen
+    this.screen = null
+    this.queue = Promise.resolve()
+  }
+
+  /**
+   * Serialize commands: the simulator handles one request at a time
+   * @param {function} task - Async task
+   * @returns {Promise} - Result of the task
+   */
+  enqueue(task) {
+    const run = this.queue.then(task, task)
+    this.queue = run.catch(() => {})
+    return run
+  }
+
+  /**
+   * Start a fresh simulator process and read its initial screen
+   */
+  async start() {
+    this.kill()
+    this.setOutput('', '')
+    this.path = []
+    this.exited = false
+
+    const child = spawn(this.command, ['-i', this.tckFile])
+    this.child = child
+    trackAllocation('simulation-sessions', 0)
+
+    child.stdout.on('data', (data) => {
+      this.setOutput(this.buffer + data.toString(), this.stderr)
+      this.flush()
+    })
+    child.stderr.on('data', (data) => {
+      this.setOutput(this.buffer, this.stderr + data.toString())
+    })
+    child.on('close', (code) => {
+      if (this.child !== child) return
+      this.exited = true
+      this.child = null
+      trackRelease('simulation-sessions', 0)
+      this.flush(code)
+    })
+    child.on('error', (error) => {
+      if (this.child !== child) return
+      this.exited = true
+      this.child = null
+      trackRelease('simulation-sessions', 0)
+      this.fail(error)
+    })
+
+    this.screen = await this.readScreen()
+  }
+
+  /**
+   * Resolve the pending read once a full screen is available
+   * @param {number} [exitCode] - Exit code when the process has terminated
+   */
+  flush(exitCode) {
+    if (!this.waiter) return
+
+    const promptAt = this.buffer.indexOf(PROMPT_MARKER)
+    if (promptAt !== -1) {
+      const selectAt = this.buffer.lastIndexOf('Select', promptAt)
+      const text = this.buffer.slice(0, selectAt === -1 ? promptAt : selectAt)
+      this.setOutput(
+        this.buffer.slice(promptAt + PROMPT_MARKER.length).replace(/^\s+/, ''),
+        this.stderr
+      )
+      this.resolveWaiter(text)
+    } else if (this.exited) {
+      if (exitCode === 0) {
+        const text = this.buffer
+        this.setOutput('', this.stderr)
+        this.resolveWaiter(text)
+      } else {
+        this.fail(new Error(`tck-simulate exited with code ${exitCode}:\n${this.stderr}`))
+      }
+    }
+  }
+
+  /**
+   * Replace the buffered simulator output, keeping the memory accounting in step
+   * @param {string} buffer - Unread stdout
+   * @param {string} stderr - Collected stderr
+   */
+  setOutput(buffer, stderr) {
+    const before = this.buffer.length + this.stderr.length
+    const after = buffer.length + stderr.length
+    if (after > before) trackAllocation('simulation-sessions', after - before, 0)
+    else trackRelease('simulation-sessions', before - after, 0)
+    this.buffer = buffer
+    this.stderr = stderr
+  }
+
+  resolveWaiter(text) {
+    const { resolve, timer } = this.waiter
+    clearTimeout(timer)
+    this.waiter = null
+    resolve(parseScreen(text))
+  }
+
+  fail(error) {
+    if (!this.waiter) return
+    const { reject, timer } = this.waiter
+    clearTimeout(timer)
+    this.waiter = null
+    reject(error)
+  }
+
+  readScreen() {
+    return new Promise((resolve, reject) => {
+      const timer = setTimeout(() => {
+        this.fail(new Error('tck-simulate did not answer in time'))
+        this.kill()
+      }, SCREEN_TIMEOUT_MS)
+      this.waiter = { resolve, reject, timer }
+      this.flush()
+    })
+  }
+
+  /**
+   * Send one choice to the simulator and read the resulting screen
+   * @param {number} index - Index of the chosen initial state or successor
+   */
+  async choose(index) {
+    if (this.exited) {
+      throw new Error('Simulation has ended: the current state has no successor')
+    }
+    const entries = this.screen.initial || this.screen.successors || []
+    if (!entries.some((entry) => entry.index === index)) {
+      throw new Error(`Out-of-range choice ${index}`)
+    }
+
+    this.child.stdin.write(`${index}\n`)
+    this.screen = await this.readScreen()
+    this.path.push(index)
+  }
+
+  /**
+   * Bring the simulator to the state reached by a sequence of choices,
+   * reusing the running process when it already is in that state
+   * @param {number[]} path - Choices from the initial screen
+   */
+  async goTo(path) {
+    const samePath =
+      !this.exited && path.length === this.path.length && path.every((c, i) => c === this.path[i])
+    if (samePath) return
+
+    await this.start()
+    for (const index of path) {
+      await this.choose(index)
+    }
+  }
+
+  /**
+   * Current state and its outgoing transitions, in the node/edge shape used by the renderer
+   * @returns {object} - { state, transitions }
+   */
+  view() {
+    const id = this.path.join('.')
+    const state = {
+      id,
+      path: [...this.path],
+      attributes: { ...(this.screen.current || {}) }
+    }
+    const transitions = (this.screen.successors || []).map((entry) => {
+      const { transition, state: targetAttributes } = splitEntry(entry.attributes)
+      return {
+        id: `${id}#${entry.index}`,
+        source: id,
+        target: `${id}.${entry.index}`,
+        attributes: transition,
+        targetAttributes
+      }
+    })
+    return { state, transitions }
+  }
+
+  /**
+   * Restart from the initial state (the first initial state when there are several)
+   * @returns {Promise<object>} - View of the initial state
+   */
+  initial() {
+    return this.enqueue(async () => {
+      await this.start()
+      if (!this.screen.initial || this.screen.initial.length === 0) {
+        throw new Error(this.stderr || 'No valid state to start simulation')
+      }
+      await this.choose(this.screen.initial[0].index)
+      return this.view()
+    })
+  }
+
+  /**
+   * Fire the k-th outgoing transition of the state reached by `path`
+   * @param {number[]} path - Choices leading to the source state
+   * @param {number} index - Transition index in that state
+   * @returns {Promise<object>} - View of the target state
+   */
+  fire(path, index) {
+    return this.enqueue(async () => {
+      await this.goTo(path)
+      await this.choose(index)
+      return this.view()
+    })
+  }
+
+  kill() {
+    if (this.child) {
+      // The close handler ignores a dropped child, so a pending read is failed here
+      this.fail(new Error('simulation session closed'))
+      const child = this.child
+      this.child = null
+      this.exited = true
+      trackRelease('simulation-sessions', 0)
+      child.kill()
+    }
+  }
+}
+
+module.exports = {
+  SimulationSession,
+  parseScreen
+}
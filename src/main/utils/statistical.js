@@ -0,0 +1,265 @@
+const { prepareModel } = require('./model-cache')
+const { SimulationSession } = require('./simulation-session')
+const { toolPath } = require('./tchecker')
+const { defaultConcurrency } = require('./task-pool')
+const { processGraphs } = require('./search-order')
+const { seededRandom, deriveSeed } = require('./random')
+
+/**
+ * Statistical Model Checking
+ * Estimates the probability that a random run reaches a labelled location, from
+ * many independent random runs instead of an exhaustive search. Runs are driven
+ * through interactive tck-simulate sessions with successors chosen by a per-worker
+ * PRNG seeded from (seed, worker index), so the samples are independent.
+ *
+ * tck-simulate cannot go back to the initial state (its prompt only takes a choice,
+ * q or r, and it exits at a state without successors), so every run pays for a
+ * fresh process: a spawn and a full parse of the model. On small models this, not
+ * the stepping, is most of the time of an estimation. Each worker starts the
+ * process of its next run while the current one is stepping, which hides the
+ * latency of the start up to the length of a run but not its CPU cost.
+ *
+ * Run j is always made by worker j mod workers, and runs are counted in the order
+ * of j whatever order they finish in, so a seed and a worker count reproduce the
+ * estimate and the sequential test decision exactly.
+ *
+ * The number of runs comes from the Chernoff-Hoeffding (Okamoto) bound: with
+ * n = ln(2/delta) / (2 epsilon^2) runs, |estimate - p| <= epsilon with probability
+ * at least 1 - delta. With a threshold, Wald's sequential probability ratio test
+ * decides "p >= threshold" or "p < threshold" and usually stops much earlier.
+ */
+
+const DEFAULT_EPSILON = 0.05
+const DEFAULT_DELTA = 0.05
+const DEFAULT_MAX_STEPS = 100
+
+/**
+ * Number of runs guaranteeing the requested precision
+ * @param {number} epsilon - Absolute error
+ * @param {number} delta - Probability of exceeding the error
+ * @returns {number} - Sample count
+ */
+function okamotoSampleCount(epsilon, delta) {
+  return Math.ceil(Math.log(2 / delta) / (2 * epsilon * epsilon))
+}
+
+/**
+ * Quantile of the standard normal distribution (Abramowitz-Stegun 26.2.23)
+ * @param {number} p - Probability in (0, 1)
+ * @returns {number} - z such that P(Z <= z) = p, within 4.5e-4
+ */
+function normalQuantile(p) {
+  if (p < 0.5) return -normalQuantile(1 - p)
+  const t = Math.sqrt(-2 * Math.log(1 - p))
+  const numerator = 2.515517 + 0.802853 * t + 0.010328 * t * t
+  const denominator = 1 + 1.432788 * t + 0.189269 * t * t + 0.001308 * t * t * t
+  return t - numerator / denominator
+}
+
+/**
+ * Wilson score interval of a binomial proportion
+ * @param {number} hits - Successes
+ * @param {number} runs - Trials
+ * @param {number} delta - 1 - confidence level
+ * @returns {number[]} - [low, high]
+ */
+function wilsonInterval(hits, runs, delta) {
+  if (runs === 0) return [0, 1]
+  const z = normalQuantile(1 - delta / 2)
+  const p = hits / runs
+  const denominator = 1 + (z * z) / runs
+  const center = (p + (z * z) / (2 * runs)) / denominator
+  const half = (z * Math.sqrt((p * (1 - p)) / runs + (z * z) / (4 * runs * runs))) / denominator
+  return [Math.max(0, center - half), Math.min(1, center + half)]
+}
+
+/**
+ * Wald's sequential probability ratio test for p >= threshold, with indifference
+ * region [threshold - epsilon, threshold + epsilon] and error bounds delta
+ */
+class SequentialTest {
+  constructor(threshold, epsilon, delta) {
+    const p0 = Math.min(1 - 1e-9, threshold + epsilon) // hypothesis "above"
+    const p1 = Math.max(1e-9, threshold - epsilon) // hypothesis "below"
+    this.hitStep = Math.log(p1 / p0)
+    this.missStep = Math.log((1 - p1) / (1 - p0))
+    this.acceptBelow = Math.log((1 - delta) / delta)
+    this.acceptAbove = Math.log(delta / (1 - delta))
+    this.ratio = 0
+    this.decision = null
+  }
+
+  add(hit) {
+    if (this.decision) return
+    this.ratio += hit ? this.hitStep : this.missStep
+    if (this.ratio >= this.acceptBelow) this.decision = 'below'
+    else if (this.ratio <= this.acceptAbove) this.decision = 'above'
+  }
+}
+
+/**
+ * Predicate telling whether a simulator state is in a location with the label
+ * @param {string} tckContent - Generated TCK model
+ * @param {string} label - Target label
+ * @returns {function} - (stateAttributes) => boolean, reading the `vloc` tuple
+ */
+function labelPredicate(tckContent, label) {
+  // Per process position, the set of locations carrying the label
+  const targets = [...processGraphs(tckContent).values()].map(
+    (graph) =>
+      new Set(
+        [...graph.labels].filter(([, labels]) => labels.includes(label)).map(([loc]) => loc)
+      )
+  )
+
+  return (attributes) => {
+    const vloc = attributes?.vloc
+    if (!vloc) return false
+    const locations = vloc.replace(/^<|>$/g, '').split(',')
+    return locations.some((location, i) => targets[i]?.has(location.trim()))
+  }
+}
+
+/**
+ * One random run of at most maxSteps transitions
+ * @param {SimulationSession} session - Session started for this run, at the initial screen
+ * @param {function} random - Worker PRNG
+ * @param {function} isTarget - Label predicate
+ * @param {number} maxSteps - Step bound
+ * @returns {Promise<boolean>} - Whether the run visited a target state
+ */
+async function sampleRun(session, random, isTarget, maxSteps) {
+  const initial = session.screen.initial || []
+  if (initial.length === 0) {
+    throw new Error(session.stderr || 'No valid state to start simulation')
+  }
+  await session.choose(initial[Math.floor(random() * initial.length)].index)
+
+  for (let step = 0; ; step++) {
+    if (isTarget(session.screen.current)) return true
+    const successors = session.screen.successors || []
+    if (step >= maxSteps || session.exited || successors.length === 0) return false
+    await session.choose(successors[Math.floor(random() * successors.length)].index)
+  }
+}
+
+/**
+ * Estimate the probability of reaching a label within a number of steps
+ * @param {object} request - { property, modelData, epsilon, delta, maxSteps, threshold,
+ *   seed, workers }
+ * @param {object} [options] - { signal: AbortSignal, onProgress: ({ runs, hits }) => void }
+ * @returns {Promise<object>} - { success, runs, hits, estimate, interval, confidence,
+ *   decision, ... }
+ */
+async function estimateProbability(request, options = {}) {
+  const { property, modelData } = request
+  const epsilon = request.epsilon || DEFAULT_EPSILON
+  const delta = request.delta || DEFAULT_DELTA
+  const maxSteps = request.maxSteps || DEFAULT_MAX_STEPS
+  const seed = request.seed ?? Date.now()
+  const workerCount = Math.max(1, request.workers || defaultConcurrency())
+
+  if (!property?.targetLabel) {
+    return { success: false, error: 'Statistical estimation needs a target label' }
+  }
+
+  const startTime = Date.now()
+  const { tckFile, tckContent } = await prepareModel(modelData)
+  const isTarget = labelPredicate(tckContent, property.targetLabel)
+  const maxRuns = okamotoSampleCount(epsilon, delta)
+  const test =
+    typeof request.threshold === 'number'
+      ? new SequentialTest(request.threshold, epsilon, delta)
+      : null
+
+  // Outcome of run j, filled by worker j mod workerCount: 0 pending, 1 miss, 2 hit
+  const outcomes = new Uint8Array(maxRuns)
+  let runs = 0
+  let hits = 0
+  let failure = null
+  const done = () => runs >= maxRuns || test?.decision || failure || options.signal?.aborted
+
+  // Count finished runs in run order, up to the first one still pending
+  const collect = () => {
+    while (runs < maxRuns && outcomes[runs] !== 0 && !test?.decision) {
+      const hit = outcomes[runs] === 2
+      runs++
+      if (hit) hits++
+      test?.add(hit)
+      if (options.onProgress && runs % 50 === 0) options.onProgress({ runs, hits })
+    }
+  }
+
+  // Killing the sessions fails the runs in progress, which stops every worker
+  const sessions = new Set()
+  const stopAll = () => sessions.forEach((session) => session.kill())
+  options.signal?.addEventListener('abort', stopAll, { once: true })
+
+  // A simulator process at its initial screen, ready for the next run
+  const startSession = () => {
+    const session = new SimulationSession(toolPath('tck-simulate'), tckFile)
+    sessions.add(session)
+    const started = session.start().then(() => session)
+    started.catch(() => {}) // reported when the run awaits it
+    return started
+  }
+  const closeSession = (session) => {
+    session.kill()
+    sessions.delete(session)
+  }
+
+  const worker = async (index) => {
+    const random = seededRandom(deriveSeed(seed, index))
+    let next = null
+
+    try {
+      for (let run = index; run < maxRuns && !done(); run += workerCount) {
+        const session = await (next || startSession())
+        next = run + workerCount < maxRuns ? startSession() : null
+        const hit = await sampleRun(session, random, isTarget, maxSteps)
+        closeSession(session)
+        outcomes[run] = hit ? 2 : 1
+        collect()
+      }
+    } catch (error) {
+      if (!failure) failure = error
+      stopAll()
+    }
+  }
+
+  try {
+    await Promise.all(Array.from({ length: workerCount }, (_, index) => worker(index)))
+  } finally {
+    options.signal?.removeEventListener('abort', stopAll)
+    stopAll()
+  }
+
+  if (options.signal?.aborted) {
+    return { success: false, cancelled: true, error: 'Estimation cancelled' }
+  }
+  if (failure) {
+    return { success: false, error: failure.message }
+  }
+
+  return {
+    success: true,
+    runs,
+    hits,
+    estimate: runs > 0 ? hits / runs : 0,
+    interval: wilsonInterval(hits, runs, delta),
+    confidence: 1 - delta,
+    epsilon,
+    maxSteps,
+    seed,
+    workers: workerCount,
+    threshold: test ? request.threshold : null,
+    decision: test ? test.decision : null,
+    elapsedSeconds: (Date.now() - startTime) / 1000
+  }
+}
+
+module.exports = {
+  estimateProbability,
+  okamotoSampleCount,
+  wilsonInterval
+}
@@ -0,0 +1,85 @@
+/**
+ * Statistics Parser
+ * Turns the `KEY value` statistics block printed by tck-reach and tck-liveness
+ * into a structured object in one pass over the output
+ */
+
+// Statistics keys reported to the renderer, by their name in the GUI
+const REACHABILITY_KEYS = {
+  reachable: 'REACHABLE',
+  coveredStates: 'COVERED_STATES',
+  storedStates: 'STORED_STATES',
+  visitedStates: 'VISITED_STATES',
+  visitedTransitions: 'VISITED_TRANSITIONS',
+  runningTime: 'RUNNING_TIME_SECONDS',
+  maxMemory: 'MEMORY_MAX_RSS'
+}
+
+/**
+ * Convert a statistics value: integers and decimals to numbers, true/false to booleans
+ * @param {string} raw - Value as printed
+ * @returns {number|boolean|string} - Typed value
+ */
+function typedValue(raw) {
+  if (raw === 'true') return true
+  if (raw === 'false') return false
+  if (/^-?\d+(\.\d+)?(e[+-]?\d+)?$/i.test(raw)) return Number(raw)
+  return raw
+}
+
+/**
+ * Parse the statistics lines of a tchecker tool output
+ * Lines that are not of the form `UPPER_CASE_KEY value` (e.g. certificate lines
+ * when no output file is given) are skipped.
+ * @param {string} stdout - Tool standard output
+ * @returns {object} - e.g. { REACHABLE: true, VISITED_STATES: 9, RUNNING_TIME_SECONDS: 0.01 }
+ */
+function parseStats(stdout) {
+  const stats = {}
+  let start = 0
+
+  while (start < stdout.length) {
+    let end = stdout.indexOf('\n', start)
+    if (end === -1) end = stdout.length
+    const line = stdout.slice(start, end).trim()
+    start = end + 1
+
+    const space = line.indexOf(' ')
+    if (space <= 0) continue
+    const key = line.slice(0, space)
+    if (!/^[A-Z][A-Z0-9_]*$/.test(key)) continue
+    stats[key] = typedValue(line.slice(space + 1).trim())
+  }
+
+  return stats
+}
+
+/**
+ * Print statistics back in the tool's `KEY value` form
+ * @param {object} stats - Parsed statistics
+ * @returns {string} - One line per statistic
+ */
+function formatStats(stats) {
+  return Object.entries(stats)
+    .map(([key, value]) => `${key} ${value}\n`)
+    .join('')
+}
+
+/**
+ * Statistics in the shape expected by the result viewers (string values)
+ * @param {object} stats - Result of parseStats
+ * @returns {object} - { reachable, visitedStates, ... } for the keys that are present
+ */
+function toReachabilityInfo(stats) {
+  const info = {}
+  for (const [name, key] of Object.entries(REACHABILITY_KEYS)) {
+    if (key in stats) info[name] = String(stats[key])
+  }
+  return info
+}
+
+module.exports = {
+  parseStats,
+  formatStats,
+  toReachabilityInfo
+}
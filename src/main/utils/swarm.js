@@ -0,0 +1,195 @@
+const fs = require('fs').promises
+const os = require('os')
+const path = require('path')
+const { defaultConcurrency } = require('./task-pool')
+const { prepareVerification, verifyProperty } = require('./verification-manager')
+const { seededRandom } = require('./random')
+
+/**
+ * Swarm Verification
+ * Runs several diversified tck-reach searches of the same property side by side
+ * and keeps the first definitive answer. Each worker gets its own variant of the
+ * model, with the location and edge declarations of every process shuffled by a
+ * per-worker seed, so that tck-reach iterates successors in a different order, and
+ * its own algorithm and search order. A counterexample that one search order finds
+ * late is often found early by another.
+ *
+ * Any worker that finishes decides the property: a found target is a witness and a
+ * completed search has explored the whole state space. The other workers are then
+ * stopped. A memory budget set on the property is shared evenly by the workers.
+ */
+
+const SWARM_DIR = path.join(os.tmpdir(), 'tchecker-gui', 'swarm')
+
+// Worker configurations, cycled through; worker 0 runs the unshuffled model
+const WORKER_CONFIGS = [
+  { algorithm: 'covreach', searchOrder: 'bfs' },
+  { algorithm: 'covreach', searchOrder: 'dfs' },
+  { algorithm: 'reach', searchOrder: 'dfs' },
+  { algorithm: 'reach', searchOrder: 'bfs' }
+]
+
+// Statistics summed over the workers that ran to completion
+const SUMMED_STATS = ['VISITED_STATES', 'VISITED_TRANSITIONS', 'STORED_STATES', 'COVERED_STATES']
+
+function shuffle(items, random) {
+  for (let i = items.length - 1; i > 0; i--) {
+    const j = Math.floor(random() * (i + 1))
+    ;[items[i], items[j]] = [items[j], items[i]]
+  }
+  return items
+}
+
+/**
+ * Shuffle the location and edge declarations within each process
+ * Locations stay ahead of the edges of their process, and all other declarations
+ * keep their position, so the variant describes the same system.
+ * @param {string} tckContent - Generated TCK model
+ * @param {number} seed - Shuffle seed
+ * @returns {string} - Equivalent TCK model
+ */
+function shuffleModel(tckContent, seed) {
+  const random = seededRandom(seed)
+  const lines = tckContent.split('\n')
+  const output = []
+
+  let i = 0
+  while (i < lines.length) {
+    const kind = ['location:', 'edge:'].find((prefix) => lines[i].startsWith(prefix))
+    if (!kind) {
+      output.push(lines[i++])
+      continue
+    }
+    const run = []
+    while (i < lines.length && lines[i].startsWith(kind)) run.push(lines[i++])
+    output.push(...shuffle(run, random))
+  }
+
+  return output.join('\n')
+}
+
+/**
+ * Combined view of the finished workers
+ * @param {object[]} results - Worker results (null for workers that did not finish)
+ * @returns {object} - Summed search statistics
+ */
+function combineStats(results) {
+  const combined = {}
+  for (const result of results) {
+    if (!result?.stats) continue
+    for (const key of SUMMED_STATS) {
+      if (typeof result.stats[key] === 'number') {
+        combined[key] = (combined[key] || 0) + result.stats[key]
+      }
+    }
+  }
+  return combined
+}
+
+/**
+ * Verify a property with a swarm of diversified searches
+ * @param {object} swarmRequest - { property, modelData, workers }
+ * @param {object} [options] - { signal: AbortSignal that stops all workers, onProgress }
+ * @returns {Promise<object>} - Result of the winning worker with a `swarm` summary, or an
+ *   'unknown' verdict when no worker could decide the property within its budget
+ */
+async function swarmVerify(swarmRequest, options = {}) {
+  const { property, modelData } = swarmRequest
+  const workerCount = Math.max(1, swarmRequest.workers || defaultConcurrency())
+  console.log(`=== Starting swarm verification with ${workerCount} workers ===`)
+
+  const prepared = await prepareVerification(modelData)
+  const { hash, tckFile, tckContent } = prepared
+  await fs.mkdir(SWARM_DIR, { recursive: true })
+
+  const variants = []
+  for (let i = 0; i < workerCount; i++) {
+    const config = WORKER_CONFIGS[i % WORKER_CONFIGS.length]
+    let file = tckFile
+    if (i > 0) {
+      file = path.join(SWARM_DIR, `${hash}-${process.pid}-${i}.tck`)
+      await fs.writeFile(file, shuffleModel(tckContent, i), 'utf8')
+    }
+    variants.push({ ...config, tckFile: file, seed: i })
+  }
+
+  const workerProperty = property.maxMemoryMB
+    ? { ...property, maxMemoryMB: Number(property.maxMemoryMB) / workerCount }
+    : property
+
+  const controllers = variants.map(() => new AbortController())
+  const stopAll = () => controllers.forEach((controller) => controller.abort())
+  options.signal?.addEventListener('abort', stopAll, { once: true })
+
+  const results = new Array(workerCount).fill(null)
+  let winner = -1
+
+  try {
+    await Promise.all(
+      variants.map(async (variant, index) => {
+        const tag = { propertyId: property.id, worker: index }
+        const onProgress =
+          options.onProgress && ((progress) => options.onProgress({ ...progress, ...tag }))
+        const result = await verifyProperty(
+          { property: workerProperty, modelData, prepared },
+          { signal: controllers[index].signal, onProgress, variant, slot: index }
+        )
+        if (result.cancelled) return
+
+        results[index] = result
+        // A crashed or OOM-killed worker still has a verdict guessed from its output
+        if (winner === -1 && result.success && result.definitive) {
+          winner = index
+          console.log(`Swarm worker ${index} decided the property (${result.verdict})`)
+          stopAll()
+        }
+      })
+    )
+  } finally {
+    options.signal?.removeEventListener('abort', stopAll)
+    for (const variant of variants.slice(1)) {
+      await fs.unlink(variant.tckFile).catch(() => {})
+    }
+  }
+
+  if (options.signal?.aborted) {
+    return { success: false, cancelled: true, error: 'Verification cancelled' }
+  }
+
+  const swarm = {
+    workers: variants.map(({ algorithm, searchOrder, seed }, index) => ({
+      algorithm,
+      searchOrder,
+      seed,
+      finished: results[index] !== null
+    })),
+    winner,
+    combinedStats: combineStats(results)
+  }
+
+  if (winner !== -1) {
+    return { ...results[winner], swarm }
+  }
+
+  // No definitive answer: report the first failure or budget exhaustion
+  const fallback = results.find((result) => result !== null)
+  if (!fallback) {
+    return { success: false, error: 'No swarm worker finished', swarm }
+  }
+  if (fallback.success && fallback.verdict !== 'unknown') {
+    const { exitCode, signal, stderr } = fallback.rawOutput || {}
+    return {
+      success: false,
+      error:
+        `No swarm worker finished cleanly (exit code ${exitCode}, signal ${signal})\n` +
+        (stderr || ''),
+      swarm
+    }
+  }
+  return { ...fallback, swarm }
+}
+
+module.exports = {
+  swarmVerify,
+  shuffleModel
+}
@@ -0,0 +1,116 @@
+const { compileProcess, instantiateProcess } = require('./tck-generator')
+
+/**
+ * Symmetry Detection
+ * Finds groups of interchangeable processes: processes with identical bodies whose
+ * exchange maps the set of synchronizations onto itself
+ */
+
+/**
+ * Expand every process of the model (plain processes and template instances)
+ * @param {object} model - JSON model
+ * @returns {Map<string, string>} - Process name -> name-independent body text
+ */
+function processBodies(model) {
+  const bodies = new Map()
+
+  for (const procName in model.processes || {}) {
+    const lines = []
+    instantiateProcess(compileProcess(model.processes[procName]), '', {}, lines)
+    bodies.set(procName, lines.join('\n'))
+  }
+
+  ;(model.instances || []).forEach((instance) => {
+    const template = model.templates?.[instance.template]
+    if (!template) return
+    const lines = []
+    instantiateProcess(
+      compileProcess(template, template.parameters),
+      '',
+      instance.arguments || {},
+      lines
+    )
+    bodies.set(instance.name, lines.join('\n'))
+  })
+
+  return bodies
+}
+
+/**
+ * Canonical key of a synchronization vector, optionally with two processes exchanged
+ * @param {string[]} constraints - Constraints such as "P@a" or "P@a?"
+ * @param {string} [p] - First exchanged process
+ * @param {string} [q] - Second exchanged process
+ * @returns {string} - Order-independent key
+ */
+function syncKey(constraints, p, q) {
+  return constraints
+    .map((constraint) => {
+      const at = constraint.indexOf('@')
+      const proc = constraint.slice(0, at)
+      const rest = constraint.slice(at)
+      if (proc === p) return q + rest
+      if (proc === q) return p + rest
+      return constraint
+    })
+    .sort()
+    .join(':')
+}
+
+/**
+ * Detect groups of symmetric processes
+ * Explicit groups from `model.symmetryGroups` are taken as given; other processes
+ * are grouped automatically when their bodies are identical and exchanging them
+ * preserves the synchronizations.
+ * @param {object} model - JSON model
+ * @returns {string[][]} - Groups of at least two process names
+ */
+function findSymmetryGroups(model) {
+  const explicit = (model.symmetryGroups || []).filter((group) => group.length > 1)
+  const assigned = new Set(explicit.flat())
+
+  const syncs = (model.synchronizations || []).map((sync) => sync.constraints || [])
+  const syncSet = new Set(syncs.map((constraints) => syncKey(constraints)))
+  const preservesSyncs = (p, q) =>
+    syncs.every((constraints) => syncSet.has(syncKey(constraints, p, q)))
+
+  // Candidate classes: processes with the same body
+  const byBody = new Map()
+  for (const [procName, body] of processBodies(model)) {
+    if (assigned.has(procName)) continue
+    if (!byBody.has(body)) byBody.set(body, [])
+    byBody.get(body).push(procName)
+  }
+
+  // Within a class, exchanges that preserve the synchronizations generate the group
+  const detected = []
+  for (const candidates of byBody.values()) {
+    const groups = []
+    for (const procName of candidates) {
+      const group = groups.find((members) => preservesSyncs(members[0], procName))
+      if (group) group.push(procName)
+      else groups.push([procName])
+    }
+    detected.push(...groups.filter((group) => group.length > 1))
+  }
+
+  return [...explicit, ...detected]
+}
+
+/**
+ * Upper bound on the state-space reduction from symmetry: product of group size factorials
+ * @param {string[][]} groups - Symmetry groups
+ * @returns {number} - Reduction factor
+ */
+function maxSymmetryReduction(groups) {
+  let factor = 1
+  for (const group of groups) {
+    for (let i = 2; i <= group.length; i++) factor *= i
+  }
+  return factor
+}
+
+module.exports = {
+  findSymmetryGroups,
+  maxSymmetryReduction
+}
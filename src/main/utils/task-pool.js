@@ -0,0 +1,50 @@
+const os = require('os')
+
+/**
+ * Task Pool
+ * Bounded-concurrency helpers for running independent tool invocations side by side
+ */
+
+/**
+ * Default number of concurrent tool processes
+ * @returns {number} - One per available CPU
+ */
+function defaultConcurrency() {
+  const cpus =
+    typeof os.availableParallelism === 'function' ? os.availableParallelism() : os.cpus().length
+  return Math.max(1, cpus)
+}
+
+/**
+ * Map an async function over items with at most `limit` calls in flight.
+ * Results are returned in input order regardless of completion order, so callers
+ * get the same output as a sequential loop.
+ * @param {Array} items - Inputs
+ * @param {number} limit - Maximum number of concurrent calls
+ * @param {function} fn - Async function (item, index) => result
+ * @returns {Promise<Array>} - Results in input order
+ */
+async function mapConcurrent(items, limit, fn) {
+  const results = new Array(items.length)
+  let next = 0
+
+  const worker = async () => {
+    while (next < items.length) {
+      const index = next++
+      results[index] = await fn(items[index], index)
+    }
+  }
+
+  const workers = []
+  const count = Math.max(1, Math.min(limit || defaultConcurrency(), items.length))
+  for (let i = 0; i < count; i++) {
+    workers.push(worker())
+  }
+  await Promise.all(workers)
+  return results
+}
+
+module.exports = {
+  defaultConcurrency,
+  mapConcurrent
+}
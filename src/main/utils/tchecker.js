@@ -0,0 +1,247 @@
+const fs = require('fs')
+const path = require('path')
+const { spawn, execFile } = require('child_process')
+const { perfAvailable, perfStatCommand, readPerfStat } = require('./perf-counters')
+const { defaultMemoryBacking, applyMemoryBacking } = require('./memory-backing')
+
+/**
+ * TChecker Tool Runner
+ * Single place that locates the tchecker binaries and runs them, so the
+ * verification and simulation managers share path resolution, output
+ * collection and cancellation
+ */
+
+let binDir = null
+
+/**
+ * Directory holding tck-reach, tck-simulate, tck-liveness and tck-syntax.
+ * TCHECKER_BIN_DIR overrides the binaries bundled under src/main/build/src.
+ * @returns {string} - Absolute directory path
+ */
+function getBinDir() {
+  if (binDir === null) {
+    binDir = process.env.TCHECKER_BIN_DIR || path.join(__dirname, '..', 'build', 'src')
+    if (!fs.existsSync(path.join(binDir, 'tck-reach'))) {
+      console.warn('tchecker binaries not found in', binDir)
+    }
+  }
+  return binDir
+}
+
+/**
+ * Absolute path of a tchecker tool
+ * @param {string} tool - Tool name, e.g. 'tck-reach'
+ * @returns {string} - Executable path
+ */
+function toolPath(tool) {
+  return path.join(getBinDir(), tool)
+}
+
+/**
+ * Identity of a tool binary: its path, size and modification time, which change
+ * when the binary directory is switched or the tool is rebuilt
+ * @param {string} tool - Tool name, e.g. 'tck-reach'
+ * @returns {string} - Identity string (the path alone when the tool is missing)
+ */
+function toolIdentity(tool) {
+  const toolFile = toolPath(tool)
+  try {
+    const { size, mtimeMs } = fs.statSync(toolFile)
+    return `${toolFile}:${size}:${mtimeMs}`
+  } catch (err) {
+    return toolFile
+  }
+}
+
+const DEFAULT_PROGRESS_INTERVAL_MS = 1000
+
+/**
+ * Resident set size of a running process
+ * Reads /proc on Linux and asks ps elsewhere.
+ * @param {number} pid - Process id
+ * @returns {Promise<number|null>} - RSS in bytes, null when the process is gone
+ */
+function sampleRss(pid) {
+  if (process.platform === 'linux') {
+    return fs.promises
+      .readFile(`/proc/${pid}/status`, 'utf8')
+      .then((status) => {
+        const match = status.match(/^VmRSS:\s+(\d+)\s+kB/m)
+        return match ? parseInt(match[1]) * 1024 : null
+      })
+      .catch(() => null)
+  }
+
+  return new Promise((resolve) => {
+    execFile('ps', ['-o', 'rss=', '-p', String(pid)], (error, stdout) => {
+      const kb = error ? NaN : parseInt(stdout.trim())
+      resolve(Number.isNaN(kb) ? null : kb * 1024)
+    })
+  })
+}
+
+/**
+ * Process id of the program started by a wrapper such as perf stat
+ * @param {number} pid - Wrapper process id
+ * @returns {number|null} - First child process id, null when it has not started yet
+ */
+function wrappedPid(pid) {
+  try {
+    const children = fs.readFileSync(`/proc/${pid}/task/${pid}/children`, 'utf8').trim()
+    return children ? parseInt(children.split(' ')[0]) : null
+  } catch (err) {
+    return null
+  }
+}
+
+/**
+ * Run a tchecker tool to completion
+ * The tools print their statistics only when they finish, so progress and budgets
+ * are tracked from the outside: the child's RSS is sampled every progressIntervalMs,
+ * and a run that exceeds its time or memory budget is stopped like a cancelled one.
+ * @param {string} tool - Tool name, e.g. 'tck-reach'
+ * @param {string[]} args - Command-line arguments
+ * @param {object} [options] - {
+ *   signal: AbortSignal to stop the run,
+ *   onSpawn: (child) => void,
+ *   timeoutMs: wall-clock budget,
+ *   maxMemoryBytes: RSS budget,
+ *   onProgress: ({ elapsedSeconds, rssBytes, peakRssBytes }) => void,
+ *   progressIntervalMs: sampling period (default 1000),
+ *   perfCounters: run under perf stat when it is available,
+ *   memoryBacking: { hugePages, numa } overriding the environment defaults,
+ *   slot: number of the run among concurrent ones, for per-node NUMA placement
+ * }
+ * @returns {Promise<object>} - { stdout, stderr, exitCode, signal, aborted, budgetExceeded,
+ *   elapsedSeconds, peakRssBytes, perfCounters } where budgetExceeded is null, 'timeout' or
+ *   'memory' and perfCounters is null unless the run was counted
+ */
+function runTool(tool, args, options = {}) {
+  const { signal, onSpawn, timeoutMs, maxMemoryBytes, onProgress } = options
+  const progressIntervalMs = options.progressIntervalMs || DEFAULT_PROGRESS_INTERVAL_MS
+
+  return new Promise((resolve, reject) => {
+    if (signal?.aborted) {
+      resolve({
+        stdout: '',
+        stderr: '',
+        exitCode: null,
+        signal: null,
+        aborted: true,
+        budgetExceeded: null,
+        elapsedSeconds: 0,
+        peakRssBytes: null,
+        perfCounters: null
+      })
+      return
+    }
+
+    const startTime = Date.now()
+    const backing = { ...defaultMemoryBacking(), ...options.memoryBacking, slot: options.slot }
+    const launch = applyMemoryBacking(toolPath(tool), args, backing)
+    const perf =
+      options.perfCounters && perfAvailable() ? perfStatCommand(launch.command, launch.args) : null
+    const child = perf
+      ? spawn(perf.command, perf.args, { env: launch.env })
+      : spawn(launch.command, launch.args, { env: launch.env })
+    // Under perf, memory and signals concern the tool, not the perf process (numactl
+    // execs the tool in place)
+    const toolPid = () => (perf && wrappedPid(child.pid)) || child.pid
+    const stop = () => {
+      try {
+        process.kill(toolPid(), 'SIGTERM')
+      } catch (err) {
+        child.kill('SIGTERM')
+      }
+    }
+    const stdoutChunks = []
+    const stderrChunks = []
+    let aborted = false
+    let budgetExceeded = null
+    let peakRssBytes = null
+    let sampling = false
+    let done = false
+
+    const onAbort = () => {
+      aborted = true
+      stop()
+    }
+    signal?.addEventListener('abort', onAbort, { once: true })
+
+    const stopOnBudget = (reason) => {
+      if (budgetExceeded || aborted) return
+      budgetExceeded = reason
+      stop()
+    }
+
+    const timeoutTimer = timeoutMs > 0 ? setTimeout(() => stopOnBudget('timeout'), timeoutMs) : null
+
+    const monitor =
+      maxMemoryBytes > 0 || onProgress
+        ? setInterval(async () => {
+            if (sampling || done) return
+            sampling = true
+            const rssBytes = await sampleRss(toolPid())
+            sampling = false
+            if (done || rssBytes === null) return
+
+            peakRssBytes = Math.max(peakRssBytes || 0, rssBytes)
+            if (maxMemoryBytes > 0 && rssBytes > maxMemoryBytes) {
+              stopOnBudget('memory')
+            }
+            if (onProgress) {
+              const elapsedSeconds = (Date.now() - startTime) / 1000
+              onProgress({ elapsedSeconds, rssBytes, peakRssBytes })
+            }
+          }, progressIntervalMs)
+        : null
+
+    const cleanup = () => {
+      done = true
+      clearTimeout(timeoutTimer)
+      clearInterval(monitor)
+      signal?.removeEventListener('abort', onAbort)
+    }
+
+    child.stdout.on('data', (data) => stdoutChunks.push(data))
+    child.stderr.on('data', (data) => stderrChunks.push(data))
+
+    const finish = (code, killSignal) => {
+      if (done) return
+      cleanup()
+      resolve({
+        stdout: Buffer.concat(stdoutChunks).toString(),
+        stderr: Buffer.concat(stderrChunks).toString(),
+        exitCode: code,
+        signal: killSignal,
+        aborted,
+        budgetExceeded,
+        elapsedSeconds: (Date.now() - startTime) / 1000,
+        peakRssBytes,
+        perfCounters: perf ? readPerfStat(perf.outputFile) : null
+      })
+    }
+
+    // A stopped run is over once the process exits, even if a grandchild still holds its pipes
+    child.on('exit', (code, killSignal) => {
+      if (aborted || budgetExceeded) finish(code, killSignal)
+    })
+    child.on('close', finish)
+
+    child.on('error', (error) => {
+      cleanup()
+      if (perf) readPerfStat(perf.outputFile)
+      reject(error)
+    })
+
+    if (onSpawn) onSpawn(child)
+  })
+}
+
+module.exports = {
+  getBinDir,
+  toolPath,
+  toolIdentity,
+  runTool,
+  sampleRss
+}
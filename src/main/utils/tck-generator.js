@@ -50,6 +50,96 @@ function formatAttributes(attrs) {
   return `{${finalAttributeString}}`
 }
 
+/**
+ * 将字符串拆分为字面量片段与参数引用。
+ * 例如 "x<=id" -> ['x<=', { param: 'id' }, '']
+ * @param {string} text - 待拆分的字符串。
+ * @param {RegExp|null} paramRegex - 匹配参数名的正则表达式，没有参数时为 null。
+ * @returns {Array} - 片段数组。
+ */
+function compileParts(text, paramRegex) {
+  if (!paramRegex) return [text]
+
+  const parts = []
+  let last = 0
+  for (const match of text.matchAll(paramRegex)) {
+    parts.push(text.slice(last, match.index), { param: match[1] })
+    last = match.index + match[0].length
+  }
+  parts.push(text.slice(last))
+  return parts
+}
+
+/**
+ * 编译进程（或进程模板）的位置和边声明。
+ * 属性只格式化一次，参数引用预先拆分出来，实例化时只需拼接字符串。
+ * @param {object} procDetails - 进程描述 { locations, edges }。
+ * @param {string[]} parameters - 模板参数名，普通进程为空数组。
+ * @returns {Array} - 编译后的声明行 { kind, suffix, parts }。
+ */
+function compileProcess(procDetails, parameters = []) {
+  const escaped = parameters.map((name) => name.replace(/[.*+?^${}()|[\]\\]/g, '\\$&'))
+  const paramRegex = escaped.length > 0 ? new RegExp(`\\b(${escaped.join('|')})\\b`, 'g') : null
+  const lines = []
+
+  // 位置
+  for (const locName in procDetails.locations) {
+    const locDetails = procDetails.locations[locName]
+    const attributes = formatAttributes({
+      isInitial: locDetails.isInitial,
+      invariant: locDetails.invariant,
+      labels: locDetails.labels,
+      isCommitted: locDetails.isCommitted,
+      isUrgent: locDetails.isUrgent
+    })
+    lines.push({
+      kind: 'location',
+      suffix: `:${locName}`,
+      parts: compileParts(attributes, paramRegex)
+    })
+  }
+
+  // 边
+  for (const edge of procDetails.edges || []) {
+    const attributes = formatAttributes({
+      guard: edge.guard,
+      action: edge.action
+    })
+    lines.push({
+      kind: 'edge',
+      suffix: `:${edge.source}:${edge.target}:${edge.event}`,
+      parts: compileParts(attributes, paramRegex)
+    })
+  }
+
+  return lines
+}
+
+/**
+ * 用进程名和实参实例化编译后的声明行。
+ * @param {Array} compiled - compileProcess 的结果。
+ * @param {string} procName - 进程（实例）名。
+ * @param {object} args - 参数名到实参的映射。
+ * @param {string[]} tckLines - 输出行数组。
+ */
+function instantiateProcess(compiled, procName, args, tckLines) {
+  for (const line of compiled) {
+    let attributes = ''
+    for (const part of line.parts) {
+      if (typeof part === 'string') {
+        attributes += part
+      } else if (part.param in args) {
+        attributes += args[part.param]
+      } else {
+        throw new Error(
+          `Process ${procName}: missing argument for template parameter ${part.param}`
+        )
+      }
+    }
+    tckLines.push(`${line.kind}:${procName}${line.suffix}${attributes}`)
+  }
+}
+
 /**
  * 从结构化的 JSON 对象生成 TChecker (.tck) 文件内容的字符串。
  * @param {object} model - 描述时间自动机的 JSON 对象。
@@ -78,33 +168,34 @@ function generateTckFromJSON(model) {
   // --- 进程定义 ---
   tckLines.push('# --- Process Definitions ---')
   for (const procName in model.processes) {
-    const procDetails = model.processes[procName]
     tckLines.push('')
     tckLines.push(`# Process: ${procName}`)
     tckLines.push(`process:${procName}{}`)
+    instantiateProcess(compileProcess(model.processes[procName]), procName, {}, tckLines)
+  }
 
-    // 位置
-    for (const locName in procDetails.locations) {
-      const locDetails = procDetails.locations[locName]
-      const attributes = formatAttributes({
-        isInitial: locDetails.isInitial,
-        invariant: locDetails.invariant,
-        labels: locDetails.labels,
-        isCommitted: locDetails.isCommitted,
-        isUrgent: locDetails.isUrgent
-      })
-      tckLines.push(`location:${procName}:${locName}${attributes}`)
+  // --- 模板实例 ---
+  // 每个模板只编译一次，所有实例共享编译结果，仅做参数替换
+  const compiledTemplates = new Map()
+  ;(model.instances || []).forEach((instance) => {
+    const template = model.templates?.[instance.template]
+    if (!template) {
+      throw new Error(`Process ${instance.name}: unknown template ${instance.template}`)
     }
-
-    // 边
-    for (const edge of procDetails.edges) {
-      const attributes = formatAttributes({
-        guard: edge.guard,
-        action: edge.action
-      })
-      tckLines.push(`edge:${procName}:${edge.source}:${edge.target}:${edge.event}${attributes}`)
+    if (!compiledTemplates.has(instance.template)) {
+      compiledTemplates.set(instance.template, compileProcess(template, template.parameters))
     }
-  }
+
+    tckLines.push('')
+    tckLines.push(`# Process: ${instance.name} (template ${instance.template})`)
+    tckLines.push(`process:${instance.name}{}`)
+    instantiateProcess(
+      compiledTemplates.get(instance.template),
+      instance.name,
+      instance.arguments || {},
+      tckLines
+    )
+  })
   tckLines.push('')
 
   // --- 同步 ---
@@ -117,4 +208,4 @@ function generateTckFromJSON(model) {
   return tckLines.join('\n')
 }
 
-module.exports = { generateTckFromJSON }
+module.exports = { generateTckFromJSON, compileProcess, instantiateProcess }
@@ -28,10 +28,29 @@ export const AutomatonModel = {
       ]
     }
   },
+  // 可选：进程模板，结构与 processes 中的进程相同，另有参数列表
+  templates: {
+    // key 是模板名
+    templateName: {
+      parameters: ['string'], // guard/action/invariant 中按标识符替换
+      locations: {},
+      edges: []
+    }
+  },
+  // 可选：模板实例，每个实例生成一个名为 name 的进程
+  instances: [
+    {
+      name: 'string',
+      template: 'string',
+      arguments: { parameterName: 'number' }
+    }
+  ],
   synchronizations: [
     {
       // constraints 数组直接对应 p@e 这种格式
       constraints: ['string']
     }
-  ]
+  ],
+  // 可选：可互换的进程组（进程名或实例名），未给出时自动检测
+  symmetryGroups: [['string']]
 }
@@ -1,7 +1,25 @@
 const fs = require('fs').promises
 const path = require('path')
-const { spawn } = require('child_process')
-const { generateTckFromJSON } = require('./tck-generator')
+const { prepareModel } = require('./model-cache')
+const { runTool, toolPath } = require('./tchecker')
+const { mapConcurrent, defaultConcurrency } = require('./task-pool')
+const { findSymmetryGroups, maxSymmetryReduction } = require('./symmetry')
+const { parseStats, formatStats, toReachabilityInfo } = require('./stats-parser')
+const { recordResult, lookupResult, lookupResults } = require('./result-store')
+const { propertyFingerprint, propertyFingerprints } = require('./property-fingerprint')
+const { selectSearchOrder } = require('./search-order')
+const { createProfile } = require('./profiler')
+const { derivePerfMetrics } = require('./perf-counters')
+const { memorySnapshot, formatMemorySnapshot } = require('./memory-accounting')
+const { searchSizing, recordSearchStats } = require('./search-sizing')
+
+// Certificates larger than this are not returned whole: only their first
+// CERTIFICATE_PREVIEW_BYTES are kept, as text for the trace and output views
+const MAX_CERTIFICATE_TEXT_BYTES = 8 * 1024 * 1024
+const CERTIFICATE_PREVIEW_BYTES = 1024 * 1024
+
+// Count hardware events of tck-reach runs with perf stat (Linux)
+const PERF_ENABLED = process.env.TCHECKER_GUI_PERF === '1'
 
 /**
  * Verification Property Manager
@@ -53,9 +71,10 @@ function getVerificationConfig(property) {
  * @param {string} stderr - Error output
  * @param {number} exitCode - Exit code
  * @param {object} property - Property configuration
+ * @param {object} stats - Statistics parsed from stdout
  * @returns {object} - Parsed verification results
  */
-function parseVerificationResult(stdout, stderr, exitCode, property) {
+function parseVerificationResult(stdout, stderr, exitCode, property, stats) {
   const result = {
     satisfied: false,
     output: stdout + (stderr ? `\n--- STDERR ---\n${stderr}` : ''),
@@ -69,7 +88,9 @@ function parseVerificationResult(stdout, stderr, exitCode, property) {
   switch (property.type) {
     case 'reachability':
       // Reachability: Check REACHABLE flag
-      if (output.includes('reachable true') || output.match(/reachable\s+true/i)) {
+      if (typeof stats.REACHABLE === 'boolean') {
+        result.satisfied = stats.REACHABLE
+      } else if (output.includes('reachable true') || output.match(/reachable\s+true/i)) {
         result.satisfied = true
       } else if (output.includes('reachable false') || output.match(/reachable\s+false/i)) {
         result.satisfied = false
@@ -81,7 +102,9 @@ function parseVerificationResult(stdout, stderr, exitCode, property) {
 
     case 'safety':
       // Safety: Satisfied if no unsafe states found (reverse logic)
-      if (output.includes('not reachable') || output.includes('unreachable') || exitCode !== 0) {
+      if (typeof stats.REACHABLE === 'boolean') {
+        result.satisfied = !stats.REACHABLE
+      } else if (output.includes('not reachable') || output.includes('unreachable') || exitCode !== 0) {
         result.satisfied = true
       }
       break
@@ -94,8 +117,11 @@ function parseVerificationResult(stdout, stderr, exitCode, property) {
       break
   }
 
-  // Extract trace information - adapted for tck-reach output format
-  result.reachabilityInfo = extractReachabilityInfo(stdout)
+  result.verdict = result.satisfied ? 'satisfied' : 'violated'
+
+  // Statistics, both typed and in the string form used by the viewers
+  result.stats = stats
+  result.reachabilityInfo = toReachabilityInfo(stats)
 
   // For reachability check, if path found, extract state information
   if (property.type === 'reachability' && result.satisfied) {
@@ -127,32 +153,242 @@ function parseVerificationResult(stdout, stderr, exitCode, property) {
   return result
 }
 
+/**
+ * Read the beginning of a certificate file, cut after its last complete line
+ * @param {string} file - Certificate file
+ * @param {number} bytes - Maximum number of bytes to read
+ * @returns {Promise<string>} - Text of the complete lines read
+ */
+async function readCertificatePreview(file, bytes) {
+  const handle = await fs.open(file, 'r')
+  try {
+    const buffer = Buffer.alloc(bytes)
+    const { bytesRead } = await handle.read(buffer, 0, bytes, 0)
+    const end = buffer.lastIndexOf(0x0a, bytesRead - 1)
+    return buffer.toString('utf8', 0, end === -1 ? bytesRead : end + 1)
+  } finally {
+    await handle.close()
+  }
+}
+
+/**
+ * Tool output followed by the certificate, as shown in the output view
+ * @param {string} stdout - Standard output
+ * @param {string} certificateText - Certificate file content (may be empty)
+ * @param {string} heading - Heading of the certificate part
+ * @returns {string}
+ */
+function combineOutput(stdout, certificateText, heading) {
+  return stdout + (certificateText ? `\n--- ${heading} ---\n${certificateText}` : '')
+}
+
+/**
+ * Heading of the certificate part of the output view
+ * @param {number} shownBytes - Length of the certificate text shown
+ * @param {number} totalBytes - Size of the certificate file
+ * @param {boolean} truncated - Whether only the beginning of the file is shown
+ * @returns {string}
+ */
+function certificateHeading(shownBytes, totalBytes, truncated) {
+  return truncated ? `证书输出（前 ${shownBytes} 字节，共 ${totalBytes} 字节）` : '证书输出'
+}
+
+/**
+ * Full verification result from a stored verdict, as if the run had just finished
+ * @param {object} stored - { verdict, satisfied, stats, dotGraph, certificatePreview,
+ *   certificateBytes } from the result store
+ * @param {object} property - Property configuration
+ * @returns {object} - Verification result marked with reused: true
+ */
+function reusedResult(stored, property) {
+  const stdout = formatStats(stored.stats)
+  const truncated = stored.certificatePreview !== undefined
+  const certificateText = truncated ? stored.certificatePreview : stored.dotGraph
+  const certificateBytes = truncated ? stored.certificateBytes : stored.dotGraph.length
+  const output = combineOutput(
+    stdout,
+    certificateText,
+    certificateHeading(certificateText.length, certificateBytes, truncated)
+  )
+  return {
+    success: true,
+    ...parseVerificationResult(output, '', 0, property, stored.stats),
+    verdict: stored.verdict,
+    satisfied: stored.satisfied,
+    dotGraph: stored.dotGraph,
+    certificateTruncated: truncated,
+    certificateBytes,
+    rawStdout: stdout,
+    certificateOutput: certificateText,
+    definitive: true,
+    reused: true
+  }
+}
+
+/**
+ * Time and memory budgets of a verification run
+ * @param {object} property - Property configuration (timeoutSeconds, maxMemoryMB, both optional)
+ * @returns {object} - { timeoutMs, maxMemoryBytes }, 0 meaning unlimited
+ */
+function getResourceLimits(property) {
+  const timeoutSeconds = Number(property.timeoutSeconds) || 0
+  const maxMemoryMB = Number(property.maxMemoryMB) || 0
+  return {
+    timeoutMs: timeoutSeconds > 0 ? timeoutSeconds * 1000 : 0,
+    maxMemoryBytes: maxMemoryMB > 0 ? maxMemoryMB * 1024 * 1024 : 0
+  }
+}
+
+/**
+ * Result of a run stopped because it exceeded its budget
+ * tck-reach prints its statistics only on completion, so the partial statistics are
+ * the ones observed from outside: elapsed time and the peak sampled RSS.
+ * @param {object} property - Property configuration
+ * @param {object} run - Result of runTool
+ * @returns {object} - Verification result with verdict 'unknown'
+ */
+function budgetExhaustedResult(property, run) {
+  const stats = parseStats(run.stdout)
+  stats.RUNNING_TIME_SECONDS = run.elapsedSeconds
+  if (run.peakRssBytes) stats.MEMORY_MAX_RSS = run.peakRssBytes
+
+  const reason =
+    run.budgetExceeded === 'timeout'
+      ? `time limit of ${property.timeoutSeconds}s`
+      : `memory limit of ${property.maxMemoryMB}MB`
+  const output =
+    `Search stopped: ${reason} exceeded.\n` +
+    `The property could not be decided within the budget.\n\n` +
+    `Elapsed time: ${run.elapsedSeconds.toFixed(2)}s\n` +
+    (run.peakRssBytes ? `Peak memory (sampled): ${run.peakRssBytes} bytes\n` : '') +
+    run.stdout
+
+  return {
+    success: true,
+    definitive: false,
+    verdict: 'unknown',
+    satisfied: null,
+    budgetExceeded: run.budgetExceeded,
+    output,
+    counterExample: null,
+    stats,
+    reachabilityInfo: toReachabilityInfo(stats),
+    dotGraph: '',
+    certificateTruncated: false,
+    rawStdout: run.stdout,
+    certificateOutput: ''
+  }
+}
+
+/**
+ * Memory report of a verification run
+ * @param {object} stats - Statistics of the run (MEMORY_MAX_RSS, when it completed)
+ * @param {number|null} sampledPeakRssBytes - Peak RSS of tck-reach sampled from outside
+ * @param {number} certificateBytes - Size of the certificate file
+ * @returns {object} - { toolMaxRssBytes, toolSampledPeakRssBytes, certificateBytes,
+ *   components, heapUsedBytes, rssBytes }
+ */
+function memoryReport(stats, sampledPeakRssBytes, certificateBytes) {
+  return {
+    toolMaxRssBytes: stats.MEMORY_MAX_RSS ?? null,
+    toolSampledPeakRssBytes: sampledPeakRssBytes,
+    certificateBytes,
+    ...memorySnapshot()
+  }
+}
+
+// Distinguishes output files of verifications started within the same millisecond
+let verificationSeq = 0
+
+/**
+ * Model-level part of a verification, shared by all properties of a model
+ * @param {object} modelData - JSON model
+ * @returns {Promise<object>} - Model cache entry { hash, tckFile, tckContent } plus symmetry,
+ *   the interchangeable process groups shown with every verdict (reused ones included)
+ */
+async function prepareVerification(modelData) {
+  const entry = await prepareModel(modelData)
+  const groups = findSymmetryGroups(modelData)
+  return { ...entry, symmetry: { groups, maxReduction: maxSymmetryReduction(groups) } }
+}
+
 /**
  * Verify the specified property
- * @param {object} verificationRequest - Verification request containing property and model data
- * @returns {Promise<object>} - Verification results
+ * With `reuse`, a verdict stored for a model with the same property fingerprint is
+ * returned without running tck-reach, so edits that cannot change it cost nothing.
+ * @param {object} verificationRequest - { property, modelData, reuse, fingerprint, prepared }
+ *   where fingerprint and prepared (result of prepareVerification), when given, were
+ *   computed by the caller for modelData
+ * @param {object} [options] - {
+ *   signal: AbortSignal that stops the tck-reach run,
+ *   onProgress: ({ elapsedSeconds, rssBytes, peakRssBytes }) => void,
+ *   variant: { tckFile, algorithm, searchOrder } to run an equivalent variant of the model
+ *     with another configuration (used by swarm verification),
+ *   slot: number of the run among concurrent ones, for NUMA placement
+ * }
+ * @returns {Promise<object>} - Verification results; verdict is 'satisfied', 'violated',
+ *   or 'unknown' when the run exceeded the property's time or memory budget. definitive
+ *   is false when the verdict is guessed from the output of a run that crashed, was
+ *   killed or did not report REACHABLE. With
+ *   TCHECKER_GUI_PROFILE=1, phaseTimings holds the time spent in each phase; with
+ *   TCHECKER_GUI_PERF=1, perfCounters holds the hardware counters of the run. memory
+ *   reports the peak RSS of tck-reach and the live and peak sizes of the main-process
+ *   caches; progress updates carry the latter as mainProcess.
  */
-async function verifyProperty(verificationRequest) {
-  const { property, modelData } = verificationRequest
+async function verifyProperty(verificationRequest, options = {}) {
+  const { property, modelData, reuse = false } = verificationRequest
   console.log('=== Starting property verification ===')
   console.log('Property:', JSON.stringify(property, null, 2))
 
-  const tempTckFile = path.join(__dirname, `verify_${Date.now()}.tck`)
-  const tempOutputFile = path.join(__dirname, `verify_output_${Date.now()}.txt`)
+  const tempOutputFile = path.join(
+    __dirname,
+    `verify_output_${process.pid}_${Date.now()}_${++verificationSeq}.txt`
+  )
+  let stdout = '',
+    stderr = '',
+    exitCode = 0,
+    exitSignal = null,
+    perfCounters = null,
+    sampledPeakRssBytes = null,
+    certificateBytes = 0
+  const profile = createProfile()
 
   try {
-    // 1. Generate TCK file
-    const tckContent = generateTckFromJSON(modelData)
+    // 1. Generate TCK file (reused from the model cache when unchanged), unless the
+    // caller prepared it for a whole batch
+    const prepared =
+      verificationRequest.prepared ||
+      (await profile.time('model-prepare', () => prepareVerification(modelData)))
+    const { tckFile: tempTckFile, tckContent, symmetry } = prepared
+    profile.count('model-prepare', 'bytes', tckContent.length)
     console.log('Generated TCK content:')
     console.log(tckContent)
-    await fs.writeFile(tempTckFile, tckContent, 'utf8')
+
+    const fingerprint =
+      verificationRequest.fingerprint ||
+      profile.time('fingerprint', () => propertyFingerprint(tckContent, property))
+    if (reuse) {
+      const stored = await profile.time('result-lookup', () => lookupResult(fingerprint, property))
+      if (stored) {
+        console.log('Reusing verdict for unchanged property fingerprint:', fingerprint)
+        return { ...reusedResult(stored, property), symmetry }
+      }
+    }
 
     // 2. 获取验证配置
     const config = getVerificationConfig(property)
+    const searchOrder = profile.time('search-order', () => selectSearchOrder(property, tckContent))
+    config.searchOrder = searchOrder.searchOrder
+    const variant = options.variant
+    if (variant) {
+      config.algorithm = variant.algorithm || config.algorithm
+      config.searchOrder = variant.searchOrder || config.searchOrder
+      searchOrder.searchOrder = config.searchOrder
+    }
     console.log('验证配置:', config)
+    const sizing = searchSizing(fingerprint, config.algorithm)
 
     // 3. 构建 tck-reach 命令
-    const tckReachPath = '/Users/zhaochen/Documents/tchecker_gui/src/main/build/src/tck-reach'
     const args = [
       '-a',
       config.algorithm,
@@ -160,52 +396,64 @@ async function verifyProperty(verificationRequest) {
       config.certificateType,
       '-s',
       config.searchOrder
-      // 暂时移除 -o 参数，让统计信息输出到 stdout
-      // '-o', tempOutputFile
     ]
 
+    // 证书写入单独的文件，stdout 只包含统计信息
+    if (config.certificateType !== 'none') {
+      args.push('-o', tempOutputFile)
+    }
+
+    // 按上次运行的状态数设置哈希表和内存池块的大小
+    args.push(...sizing.args)
+
     // 添加标签参数（如果需要）
     if (config.labels.length > 0) {
       args.push('-l', config.labels.join(','))
     }
 
     // 添加输入文件
-    args.push(tempTckFile)
+    args.push(variant?.tckFile || tempTckFile)
 
-    console.log('执行命令:', tckReachPath, args.join(' '))
+    console.log('执行命令:', toolPath('tck-reach'), args.join(' '))
 
     // 4. 执行 tck-reach
-    let stdout = '',
-      stderr = '',
-      exitCode = 0
     try {
-      const result = await new Promise((resolve, reject) => {
-        const child = spawn(tckReachPath, args)
-        let stdoutData = ''
-        let stderrData = ''
-
-        child.stdout.on('data', (data) => {
-          stdoutData += data.toString()
-        })
-
-        child.stderr.on('data', (data) => {
-          stderrData += data.toString()
-        })
-
-        child.on('close', (code) => {
-          resolve({
-            stdout: stdoutData,
-            stderr: stderrData,
-            exitCode: code
-          })
+      const result = await profile.time('tck-reach', () =>
+        runTool('tck-reach', args, {
+          signal: options.signal,
+          onProgress:
+            options.onProgress &&
+            ((progress) => options.onProgress({ ...progress, mainProcess: memorySnapshot() })),
+          perfCounters: PERF_ENABLED,
+          slot: options.slot,
+          ...getResourceLimits(property)
         })
+      )
+      profile.count('tck-reach', 'stdoutBytes', result.stdout.length)
+
+      if (result.aborted) {
+        return {
+          success: false,
+          cancelled: true,
+          error: 'Verification cancelled'
+        }
+      }
 
-        child.on('error', reject)
-      })
+      if (result.budgetExceeded) {
+        console.log('tck-reach 超出资源预算:', result.budgetExceeded)
+        const exhausted = budgetExhaustedResult(property, result)
+        exhausted.memory = memoryReport(exhausted.stats, result.peakRssBytes, 0)
+        console.log(`Memory at budget stop:\n${formatMemorySnapshot(exhausted.memory)}`)
+        if (profile.enabled) exhausted.phaseTimings = profile.toJSON()
+        return exhausted
+      }
 
       stdout = result.stdout
       stderr = result.stderr
       exitCode = result.exitCode
+      exitSignal = result.signal
+      perfCounters = result.perfCounters
+      sampledPeakRssBytes = result.peakRssBytes
     } catch (spawnError) {
       throw new Error(`Failed to execute tck-reach: ${spawnError.message}`)
     }
@@ -219,16 +467,31 @@ async function verifyProperty(verificationRequest) {
       console.log(stderr)
     }
 
-    // 5. 读取输出文件（如果存在）
+    // 5. 读取证书文件（如果存在）
     let outputFileContent = ''
     let dotContent = ''
+    let certificateTruncated = false
     try {
-      outputFileContent = await fs.readFile(tempOutputFile, 'utf8')
-      console.log('输出文件内容:', outputFileContent)
-
-      // 如果输出文件包含DOT格式内容，保存它
-      if (outputFileContent.includes('digraph') || outputFileContent.includes('->')) {
-        dotContent = outputFileContent
+      const { size } = await fs.stat(tempOutputFile)
+      profile.count('certificate-read', 'bytes', size)
+      certificateBytes = size
+      if (size <= MAX_CERTIFICATE_TEXT_BYTES) {
+        outputFileContent = await profile.time('certificate-read', () =>
+          fs.readFile(tempOutputFile, 'utf8')
+        )
+        console.log('输出文件内容:', outputFileContent)
+
+        // 如果输出文件包含DOT格式内容，保存它
+        if (outputFileContent.includes('digraph') || outputFileContent.includes('->')) {
+          dotContent = outputFileContent
+        }
+      } else {
+        // 大型证书：只保留开头部分作为文本，不绘制状态图
+        console.log(`证书文件较大 (${size} 字节)，只保留前 ${CERTIFICATE_PREVIEW_BYTES} 字节`)
+        outputFileContent = await profile.time('certificate-read', () =>
+          readCertificatePreview(tempOutputFile, CERTIFICATE_PREVIEW_BYTES)
+        )
+        certificateTruncated = true
       }
     } catch (err) {
       console.log('无法读取输出文件:', err.message)
@@ -246,31 +509,67 @@ async function verifyProperty(verificationRequest) {
       }
     }
 
-    // 7. 解析结果 - 确保从所有输出源提取统计信息
-    const combinedOutput =
-      stdout + (outputFileContent ? `\n--- 证书输出 ---\n${outputFileContent}` : '')
-    console.log('Combined output for parsing:', combinedOutput)
-    console.log('Extracting reachability info from:', stdout || outputFileContent || 'no output')
-
-    const result = parseVerificationResult(combinedOutput, stderr, exitCode, property)
+    // 7. 解析结果 - 统计信息只来自 stdout，证书来自输出文件
+    const stats = profile.time('stats-parse', () => parseStats(stdout))
+    // The tool's own running time is the search; the rest of the run is process overhead
+    profile.split('tck-reach', 'search', stats.RUNNING_TIME_SECONDS)
+    if (typeof stats.VISITED_STATES === 'number') {
+      profile.count('tck-reach', 'visitedStates', stats.VISITED_STATES)
+    }
+    const combinedOutput = combineOutput(
+      stdout,
+      outputFileContent,
+      certificateHeading(outputFileContent.length, certificateBytes, certificateTruncated)
+    )
 
-    // Ensure reachabilityInfo is correctly extracted
-    result.reachabilityInfo = extractReachabilityInfo(stdout || outputFileContent || combinedOutput)
-    console.log('Extracted reachabilityInfo:', result.reachabilityInfo)
+    const result = parseVerificationResult(combinedOutput, stderr, exitCode, property, stats)
+    console.log('Parsed statistics:', result.stats)
 
     // 添加DOT内容和原始输出到结果中
     result.dotGraph = dotContent
+    result.certificateTruncated = certificateTruncated
+    result.certificateBytes = certificateBytes
     result.rawStdout = stdout
     result.certificateOutput = outputFileContent
+    result.searchOrder = searchOrder
+    result.searchSizing = {
+      tableSize: sizing.tableSize,
+      blockSize: sizing.blockSize,
+      expectedStates: sizing.expectedStates,
+      loadFactor:
+        typeof stats.STORED_STATES === 'number' ? stats.STORED_STATES / sizing.tableSize : null
+    }
+    result.rawOutput.signal = exitSignal
+    // Only a clean exit with the REACHABLE statistic is a verdict; a crashed or killed run
+    // falls back to guesses from the output (a failed safety check reads as satisfied)
+    const definitive = exitCode === 0 && !exitSignal && typeof stats.REACHABLE === 'boolean'
+    if (definitive) recordSearchStats(fingerprint, config.algorithm, stats)
 
     // Ensure reachabilityInfo is correctly extracted
     console.log('Parsed reachabilityInfo:', result.reachabilityInfo)
     console.log('验证结果:', result)
 
-    return {
+    const verification = {
       success: true,
       ...result
     }
+    if (definitive) {
+      await profile.time('result-record', () => recordResult(fingerprint, property, verification))
+    }
+    verification.symmetry = symmetry
+    verification.definitive = definitive
+    // Measurements of this run only, not part of the stored verdict
+    verification.memory = memoryReport(stats, sampledPeakRssBytes, certificateBytes)
+    console.log(`Memory after verification:\n${formatMemorySnapshot(verification.memory)}`)
+    if (perfCounters) {
+      verification.perfCounters = derivePerfMetrics(perfCounters, stats)
+      console.log('Hardware counters:', verification.perfCounters)
+    }
+    if (profile.enabled) {
+      verification.phaseTimings = profile.toJSON()
+      console.log(`Phase breakdown (${property.id || property.type}):\n${profile.format()}`)
+    }
+    return verification
   } catch (error) {
     console.error('验证过程出错:', error)
     return {
@@ -283,9 +582,8 @@ async function verifyProperty(verificationRequest) {
       modelErrorDetails: stderr || error.message
     }
   } finally {
-    // 7. 清理临时文件
+    // 7. 清理临时文件 (TCK 文件由模型缓存管理)
     try {
-      await fs.unlink(tempTckFile)
       await fs.unlink(tempOutputFile)
     } catch (err) {
       if (err.code !== 'ENOENT') {
@@ -296,36 +594,67 @@ async function verifyProperty(verificationRequest) {
 }
 
 /**
- * Extract reachability statistics from tck-reach output
+ * Verify several properties of the same model concurrently
+ * Each property runs in its own tck-reach process; results are merged in request
+ * order so the outcome is identical to verifying the properties one by one.
+ * Every finished run is checkpointed in the result store; with `resume`, properties
+ * whose verdict is known for an equivalent model (same property fingerprint) are
+ * answered from the store and only the remaining ones are run.
+ * @param {object} batchRequest - { properties, modelData, concurrency, resume }
+ * @param {object} [options] - { signal: AbortSignal that stops all remaining runs,
+ *   onProgress: progress callback, called with the propertyId of the reporting run }
+ * @returns {Promise<object>} - { success, results } with one result per property
  */
-function extractReachabilityInfo(stdout) {
-  const info = {}
-
-  const patterns = [
-    { key: 'reachable', regex: /REACHABLE\s+(\w+)/i },
-    { key: 'coveredStates', regex: /COVERED_STATES\s+(\d+)/i },
-    { key: 'storedStates', regex: /STORED_STATES\s+(\d+)/i },
-    { key: 'visitedStates', regex: /VISITED_STATES\s+(\d+)/i },
-    { key: 'visitedTransitions', regex: /VISITED_TRANSITIONS\s+(\d+)/i },
-    { key: 'runningTime', regex: /RUNNING_TIME_SECONDS\s+([\d.]+)/i },
-    { key: 'maxMemory', regex: /MEMORY_MAX_RSS\s+(\d+)/i }
-  ]
-
-  console.log('Extracting from stdout:', stdout)
-
-  patterns.forEach(({ key, regex }) => {
-    const match = stdout.match(regex)
-    if (match) {
-      console.log(`Found ${key}: ${match[1]}`)
-      info[key] = match[1]
-    } else {
-      console.log(`No match for ${key} with regex ${regex}`)
+async function verifyProperties(batchRequest, options = {}) {
+  const { properties = [], modelData, concurrency, resume = false } = batchRequest
+  console.log(`=== Starting batch verification of ${properties.length} properties ===`)
+
+  // Generate the model and find its symmetries once; the concurrent runs share them
+  const prepared = await prepareVerification(modelData)
+  const { tckContent, symmetry } = prepared
+
+  // Fingerprint the whole batch in one pass over the model, then look it up at once
+  const fingerprints = propertyFingerprints(tckContent, properties)
+  const stored = resume
+    ? await lookupResults(fingerprints, properties)
+    : new Array(properties.length).fill(null)
+  const results = stored.map(
+    (record, index) => record && { ...reusedResult(record, properties[index]), symmetry }
+  )
+  const pending = []
+  for (let i = 0; i < properties.length; i++) {
+    if (!results[i]) pending.push(i)
+  }
+  if (resume) {
+    console.log(`Resuming: ${properties.length - pending.length} result(s) from checkpoint`)
+  }
+
+  await mapConcurrent(pending, concurrency || defaultConcurrency(), async (index) => {
+    const property = properties[index]
+    const onProgress =
+      options.onProgress &&
+      ((progress) => options.onProgress({ propertyId: property.id, ...progress }))
+    try {
+      results[index] = await verifyProperty(
+        { property, modelData, fingerprint: fingerprints[index], prepared },
+        { ...options, onProgress, slot: index }
+      )
+    } catch (error) {
+      results[index] = { success: false, error: error.message }
     }
   })
 
-  return info
+  return {
+    success: true,
+    results: properties.map((property, index) => ({
+      propertyId: property.id,
+      ...results[index]
+    }))
+  }
 }
 
 module.exports = {
-  verifyProperty
+  prepareVerification,
+  verifyProperty,
+  verifyProperties
 }
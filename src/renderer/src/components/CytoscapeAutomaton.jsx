@@ -43,45 +43,52 @@ const CytoscapeAutomaton = ({
   }
 
   // 转换节点数据格式 - 优化为只包含基础数据，不包含状态类
-  const cytoscapeElements = React.useMemo(() => [
-    ...nodes.map(node => ({
-      data: {
-        id: node.id,
-        label: createNodeLabel(node.data),
-        ...node.data
-      },
-      position: node.position,
-      // 初始不设置状态类，通过动态更新处理
-      classes: ''
-    })),
-    ...edges.map((edge) => {
-      // 计算平行边的偏移
-      const parallelEdges = edges.filter(e => 
-        (e.source === edge.source && e.target === edge.target) ||
-        (e.source === edge.target && e.target === edge.source)
-      )
-      
-      const sameDirectionEdges = edges.filter(e => 
-        e.source === edge.source && e.target === edge.target
-      )
-      
-      const edgeIndex = sameDirectionEdges.findIndex(e => e.id === edge.id)
-      const totalParallel = parallelEdges.length
-      
-      return {
+  const cytoscapeElements = React.useMemo(() => {
+    // 先按 (source, target) 一次性分组，每条边只需查表，而不是各自扫描全部边
+    const sameDirection = new Map()
+    for (const edge of edges) {
+      const key = `${edge.source}->${edge.target}`
+      if (!sameDirection.has(key)) sameDirection.set(key, [])
+      sameDirection.get(key).push(edge.id)
+    }
+
+    return [
+      ...nodes.map(node => ({
         data: {
-          id: edge.id,
-          source: edge.source,
-          target: edge.target,
-          label: createEdgeLabel(edge.data),
-          edgeIndex,
-          totalParallel,
-          ...edge.data
+          id: node.id,
+          label: createNodeLabel(node.data),
+          ...node.data
         },
-        classes: totalParallel > 1 ? `parallel-edge parallel-${edgeIndex}` : ''
-      }
-    })
-  ], [nodes, edges]) // Re-create when nodes or edges change
+        position: node.position,
+        // 初始不设置状态类，通过动态更新处理
+        classes: ''
+      })),
+      ...edges.map((edge) => {
+        // 计算平行边的偏移（同向与反向的边都算平行边，自环只算一次）
+        const sameDirectionEdges = sameDirection.get(`${edge.source}->${edge.target}`)
+        const reverseEdges =
+          edge.source === edge.target
+            ? []
+            : sameDirection.get(`${edge.target}->${edge.source}`) || []
+
+        const edgeIndex = sameDirectionEdges.indexOf(edge.id)
+        const totalParallel = sameDirectionEdges.length + reverseEdges.length
+      
+        return {
+          data: {
+            id: edge.id,
+            source: edge.source,
+            target: edge.target,
+            label: createEdgeLabel(edge.data),
+            edgeIndex,
+            totalParallel,
+            ...edge.data
+          },
+          classes: totalParallel > 1 ? `parallel-edge parallel-${edgeIndex}` : ''
+        }
+      })
+    ]
+  }, [nodes, edges]) // Re-create when nodes or edges change
 
   // 创建边标签
   function createEdgeLabel(edgeData) {
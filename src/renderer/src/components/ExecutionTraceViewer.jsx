@@ -84,6 +84,15 @@ const ExecutionTraceViewer = ({
 
   return (
     <Box sx={{ height: '100%', display: 'flex', flexDirection: 'column' }}>
+      {/* 证书过大时只收到了开头部分 */}
+      {verificationResult.certificateTruncated && (
+        <Alert severity="warning" sx={{ mb: 2, flexShrink: 0 }}>
+          The certificate is {formatMemory(verificationResult.certificateBytes)}; only its
+          first {formatMemory(verificationResult.certificateOutput?.length || 0)} are shown and
+          the trace below may be incomplete.
+        </Alert>
+      )}
+
       {/* Performance Statistics */}
       {(reachabilityInfo.visitedStates || reachabilityInfo.runningTime || reachabilityInfo.maxMemory) && (
         <Card variant="outlined" sx={{ mb: 2, flexShrink: 0 }}>
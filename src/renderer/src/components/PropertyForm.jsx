@@ -19,7 +19,10 @@ const PropertyForm = ({ open, property, availableLabels, onSave, onClose }) => {
   const [formData, setFormData] = useState({
     name: '',
     type: 'reachability',
-    targetLabel: ''
+    targetLabel: '',
+    searchOrder: 'bfs',
+    timeoutSeconds: '',
+    maxMemoryMB: ''
   })
   const [errors, setErrors] = useState({})
 
@@ -28,13 +31,19 @@ const PropertyForm = ({ open, property, availableLabels, onSave, onClose }) => {
       setFormData({
         name: property.name || '',
         type: property.type || 'reachability',
-        targetLabel: property.targetLabel || ''
+        targetLabel: property.targetLabel || '',
+        searchOrder: property.searchOrder || 'bfs',
+        timeoutSeconds: property.timeoutSeconds || '',
+        maxMemoryMB: property.maxMemoryMB || ''
       })
     } else {
       setFormData({
         name: '',
         type: 'reachability',
-        targetLabel: ''
+        targetLabel: '',
+        searchOrder: 'bfs',
+        timeoutSeconds: '',
+        maxMemoryMB: ''
       })
     }
     setErrors({})
@@ -67,6 +76,13 @@ const PropertyForm = ({ open, property, availableLabels, onSave, onClose }) => {
       newErrors.targetLabel = '该验证类型需要选择目标标签'
     }
 
+    // 资源限制可以留空（不限制），填写时必须为正数
+    for (const field of ['timeoutSeconds', 'maxMemoryMB']) {
+      if (formData[field] !== '' && !(Number(formData[field]) > 0)) {
+        newErrors[field] = '请输入正数，或留空表示不限制'
+      }
+    }
+
     setErrors(newErrors)
     return Object.keys(newErrors).length === 0
   }
@@ -177,6 +193,40 @@ const PropertyForm = ({ open, property, availableLabels, onSave, onClose }) => {
           </Alert>
         )}
 
+        <FormControl fullWidth>
+          <InputLabel>搜索顺序</InputLabel>
+          <Select
+            value={formData.searchOrder}
+            onChange={handleChange('searchOrder')}
+            label="搜索顺序"
+          >
+            <MenuItem value="bfs">广度优先 (BFS，反例最短)</MenuItem>
+            <MenuItem value="dfs">深度优先 (DFS，适合深层目标)</MenuItem>
+            <MenuItem value="auto">自动 (按目标标签的距离选择)</MenuItem>
+          </Select>
+        </FormControl>
+
+        <Box sx={{ display: 'flex', gap: 2 }}>
+          <TextField
+            label="时间限制 (秒)"
+            type="number"
+            value={formData.timeoutSeconds}
+            onChange={handleChange('timeoutSeconds')}
+            error={!!errors.timeoutSeconds}
+            helperText={errors.timeoutSeconds || '留空表示不限制'}
+            fullWidth
+          />
+          <TextField
+            label="内存限制 (MB)"
+            type="number"
+            value={formData.maxMemoryMB}
+            onChange={handleChange('maxMemoryMB')}
+            error={!!errors.maxMemoryMB}
+            helperText={errors.maxMemoryMB || '超出限制时结果为"未知"'}
+            fullWidth
+          />
+        </Box>
+
         {/* 属性预览 */}
         <Box sx={{ p: 2, bgcolor: 'grey.50', borderRadius: 1 }}>
           <Typography variant="subtitle2" color="primary" gutterBottom>
@@ -14,7 +14,9 @@ import {
   CircularProgress,
   TextField,
   Tabs,
-  Tab
+  Tab,
+  FormControlLabel,
+  Checkbox
 } from '@mui/material'
 import {
   Add as AddIcon,
@@ -42,6 +44,29 @@ const VerifierTab = () => {
   const [verificationResult, setVerificationResult] = useState(null)
   const [verificationError, setVerificationError] = useState(null)
   const [resultTab, setResultTab] = useState('output') // 'output', 'graph', 'trace'
+  const [batchResults, setBatchResults] = useState({}) // propertyId -> result of "Verify All"
+  const [progress, setProgress] = useState({}) // propertyId -> latest progress of a running search
+  const [estimation, setEstimation] = useState(null) // result of the statistical estimation
+  const [reuseVerdicts, setReuseVerdicts] = useState(true) // reuse stored verdicts
+
+  // Progress events sent by the main process while tck-reach runs
+  useEffect(() => {
+    const { ipcRenderer } = window.require('electron')
+    const onProgress = (_event, update) => {
+      // Swarm workers report separately for the same property
+      const key = update.worker === undefined ? update.propertyId : `${update.propertyId}#${update.worker}`
+      setProgress(prev => ({ ...prev, [key]: update }))
+    }
+    const onEstimationProgress = (_event, update) => {
+      setProgress({ [update.propertyId]: update })
+    }
+    ipcRenderer.on('verification-progress', onProgress)
+    ipcRenderer.on('estimation-progress', onEstimationProgress)
+    return () => {
+      ipcRenderer.removeListener('verification-progress', onProgress)
+      ipcRenderer.removeListener('estimation-progress', onEstimationProgress)
+    }
+  }, [])
 
   // Extract all labels
   const getAllLabels = () => {
@@ -83,6 +108,9 @@ const VerifierTab = () => {
       setProperties(properties.map(p => 
         p.id === editingProperty.id ? { ...property, id: editingProperty.id } : p
       ))
+      // The previous batch result no longer describes the edited property
+      const { [editingProperty.id]: _stale, ...remainingResults } = batchResults
+      setBatchResults(remainingResults)
     } else {
       // Add new property
       const newProperty = { ...property, id: Date.now().toString() }
@@ -96,6 +124,34 @@ const VerifierTab = () => {
     setSelectedProperty(property)
     setVerificationResult(null)
     setVerificationError(null)
+    setEstimation(null)
+
+    // Show the result from the last "Verify All" run, if any
+    const batchResult = batchResults[property.id]
+    if (batchResult) {
+      showVerificationResult(batchResult)
+    }
+  }
+
+  const showVerificationResult = (result) => {
+    if (result.success) {
+      setVerificationResult(result)
+      // Auto-select tab based on available content
+      if (result.dotGraph) {
+        setResultTab('graph')
+      } else if (result.counterExample) {
+        setResultTab('trace')
+      } else {
+        setResultTab('output')
+      }
+    } else {
+      // Handle different types of errors
+      if (result.isModelError) {
+        setVerificationError(`Model Error: ${result.modelErrorDetails}\n\nThis usually occurs due to:\n• Variable values exceeding defined ranges\n• Syntax errors in the model\n• Inappropriate clock constraints\n\nPlease check the model definition, especially variable ranges and transition actions.`)
+      } else {
+        setVerificationError(result.error)
+      }
+    }
   }
 
   const handleVerifyProperty = async () => {
@@ -104,31 +160,109 @@ const VerifierTab = () => {
     setIsVerifying(true)
     setVerificationResult(null)
     setVerificationError(null)
+    setProgress({})
 
     try {
       const { ipcRenderer } = window.require('electron')
       const result = await ipcRenderer.invoke('verify-property', {
+        property: selectedProperty,
+        modelData: useEditorStore.getState().convertModelDataForBackend(),
+        reuse: reuseVerdicts
+      })
+
+      showVerificationResult(result)
+    } catch (error) {
+      setVerificationError(error.message)
+    } finally {
+      setIsVerifying(false)
+    }
+  }
+
+  const handleSwarmVerify = async () => {
+    if (!selectedProperty) return
+
+    setIsVerifying(true)
+    setVerificationResult(null)
+    setVerificationError(null)
+    setProgress({})
+
+    try {
+      const { ipcRenderer } = window.require('electron')
+      const result = await ipcRenderer.invoke('swarm-verify-property', {
+        property: selectedProperty,
+        modelData: useEditorStore.getState().convertModelDataForBackend()
+      })
+
+      showVerificationResult(result)
+    } catch (error) {
+      setVerificationError(error.message)
+    } finally {
+      setIsVerifying(false)
+    }
+  }
+
+  const handleEstimateProbability = async () => {
+    if (!selectedProperty?.targetLabel) return
+
+    setIsVerifying(true)
+    setVerificationResult(null)
+    setVerificationError(null)
+    setEstimation(null)
+    setProgress({})
+
+    try {
+      const { ipcRenderer } = window.require('electron')
+      const result = await ipcRenderer.invoke('estimate-probability', {
         property: selectedProperty,
         modelData: useEditorStore.getState().convertModelDataForBackend()
       })
 
       if (result.success) {
-        setVerificationResult(result)
-        // Auto-select tab based on available content
-        if (result.dotGraph) {
-          setResultTab('graph')
-        } else if (result.counterExample) {
-          setResultTab('trace')
-        } else {
-          setResultTab('output')
-        }
-      } else {
-        // Handle different types of errors
-        if (result.isModelError) {
-          setVerificationError(`Model Error: ${result.modelErrorDetails}\n\nThis usually occurs due to:\n• Variable values exceeding defined ranges\n• Syntax errors in the model\n• Inappropriate clock constraints\n\nPlease check the model definition, especially variable ranges and transition actions.`)
-        } else {
-          setVerificationError(result.error)
-        }
+        setEstimation(result)
+      } else if (!result.cancelled) {
+        setVerificationError(result.error)
+      }
+    } catch (error) {
+      setVerificationError(error.message)
+    } finally {
+      setIsVerifying(false)
+    }
+  }
+
+  const handleCancelVerification = async () => {
+    const { ipcRenderer } = window.require('electron')
+    await ipcRenderer.invoke('cancel-verification')
+  }
+
+  const handleVerifyAll = async () => {
+    if (properties.length === 0) return
+
+    setIsVerifying(true)
+    setVerificationResult(null)
+    setVerificationError(null)
+    setProgress({})
+
+    try {
+      const { ipcRenderer } = window.require('electron')
+      const batch = await ipcRenderer.invoke('verify-properties', {
+        properties,
+        modelData: useEditorStore.getState().convertModelDataForBackend(),
+        resume: reuseVerdicts // verdicts the edits since the last run cannot affect are reused
+      })
+
+      if (!batch.success) {
+        setVerificationError(batch.error)
+        return
+      }
+
+      const resultsById = {}
+      batch.results.forEach(result => {
+        resultsById[result.propertyId] = result
+      })
+      setBatchResults(resultsById)
+
+      if (selectedProperty && resultsById[selectedProperty.id]) {
+        showVerificationResult(resultsById[selectedProperty.id])
       }
     } catch (error) {
       setVerificationError(error.message)
@@ -148,12 +282,18 @@ const VerifierTab = () => {
 
   const getVerificationStatusColor = (result) => {
     if (!result) return 'info'
+    if (result.verdict === 'unknown') return 'warning'
     return result.satisfied ? 'success' : 'error'
   }
 
   const getVerificationStatusText = (result) => {
     if (!result) return ''
-    
+    if (result.verdict === 'unknown') {
+      return result.budgetExceeded === 'memory'
+        ? 'Unknown (Memory Limit Exceeded)'
+        : 'Unknown (Time Limit Exceeded)'
+    }
+
     switch (selectedProperty.type) {
       case 'reachability':
         return result.satisfied ? 'Property Reachable' : 'Property Unreachable'
@@ -166,6 +306,20 @@ const VerifierTab = () => {
     }
   }
 
+  const getProgressText = () => {
+    const updates = Object.values(progress)
+    if (updates.length === 0) return ''
+    if (updates[0].runs !== undefined) {
+      return `Random runs: ${updates[0].runs} · Target reached: ${updates[0].hits}`
+    }
+    const elapsed = Math.max(...updates.map(update => update.elapsedSeconds))
+    const rssBytes = updates.reduce((sum, update) => sum + (update.rssBytes || 0), 0)
+    // Caches of the main process (model cache, result store, simulator sessions)
+    const mainProcess = updates.find(update => update.mainProcess)?.mainProcess
+    return `Elapsed: ${elapsed.toFixed(1)}s · Memory: ${(rssBytes / (1024 * 1024)).toFixed(1)}MB` +
+      (mainProcess ? ` · App: ${(mainProcess.rssBytes / (1024 * 1024)).toFixed(1)}MB` : '')
+  }
+
   return (
     <Box sx={{ height: '100%', display: 'flex', flexDirection: 'column', p: 2, overflow: 'hidden' }}>
       <Typography variant="h5" gutterBottom>
@@ -274,6 +428,47 @@ const VerifierTab = () => {
                 Please select a property
               </Button>
             )}
+            <Button
+              fullWidth
+              variant="outlined"
+              startIcon={<PlayArrowIcon />}
+              onClick={handleSwarmVerify}
+              disabled={isVerifying || !selectedProperty}
+              sx={{ mt: 1 }}
+            >
+              Swarm Search (all cores)
+            </Button>
+            <Button
+              fullWidth
+              variant="outlined"
+              startIcon={<PlayArrowIcon />}
+              onClick={handleEstimateProbability}
+              disabled={isVerifying || !selectedProperty?.targetLabel}
+              sx={{ mt: 1 }}
+            >
+              Estimate Probability (Random Runs)
+            </Button>
+            <Button
+              fullWidth
+              variant="outlined"
+              startIcon={<PlayArrowIcon />}
+              onClick={handleVerifyAll}
+              disabled={isVerifying || properties.length === 0}
+              sx={{ mt: 1 }}
+            >
+              Verify All ({properties.length})
+            </Button>
+            <FormControlLabel
+              control={
+                <Checkbox
+                  checked={reuseVerdicts}
+                  onChange={(e) => setReuseVerdicts(e.target.checked)}
+                  size="small"
+                />
+              }
+              label="Reuse earlier verdicts (uncheck to re-verify)"
+              sx={{ mt: 1 }}
+            />
           </Box>
         </Paper>
 
@@ -295,7 +490,7 @@ const VerifierTab = () => {
             </Box>
           )}
 
-          {selectedProperty && !verificationResult && !verificationError && !isVerifying && (
+          {selectedProperty && !verificationResult && !verificationError && !isVerifying && !estimation && (
             <Box sx={{ 
               display: 'flex', 
               alignItems: 'center', 
@@ -317,10 +512,29 @@ const VerifierTab = () => {
               gap: 2
             }}>
               <CircularProgress size={60} />
-              <Typography>Verifying property: {selectedProperty.name}</Typography>
+              <Typography>
+                {selectedProperty ? `Verifying property: ${selectedProperty.name}` : 'Verifying all properties'}
+              </Typography>
+              <Typography variant="body2" color="textSecondary">
+                {getProgressText()}
+              </Typography>
+              <Button variant="outlined" color="error" onClick={handleCancelVerification}>
+                Cancel
+              </Button>
             </Box>
           )}
 
+          {estimation && !isVerifying && (
+            <Alert severity="info" sx={{ mb: 2 }}>
+              <Typography variant="subtitle1">
+                P(reach {selectedProperty?.targetLabel} within {estimation.maxSteps} steps) ≈ {estimation.estimate.toFixed(3)}
+              </Typography>
+              <Typography variant="body2">
+                {Math.round(estimation.confidence * 100)}% confidence interval: [{estimation.interval[0].toFixed(3)}, {estimation.interval[1].toFixed(3)}] from {estimation.runs} random runs
+              </Typography>
+            </Alert>
+          )}
+
           {verificationError && (
             <Alert severity="error" sx={{ mb: 2 }}>
               Verification failed: {verificationError}
@@ -339,6 +553,26 @@ const VerifierTab = () => {
                 <Typography variant="body2">
                   Property: {selectedProperty.name}
                 </Typography>
+                {verificationResult.swarm && (
+                  <Typography variant="caption" display="block">
+                    Swarm: worker {verificationResult.swarm.winner} of {verificationResult.swarm.workers.length} decided the property
+                  </Typography>
+                )}
+                {verificationResult.reused && (
+                  <Typography variant="caption">
+                    Result reused: model changes since the last run cannot affect this property
+                  </Typography>
+                )}
+                {verificationResult.symmetry?.groups.length > 0 && (
+                  <Typography variant="caption" display="block">
+                    Symmetric processes:{' '}
+                    {verificationResult.symmetry.groups
+                      .map((group) => `{${group.join(', ')}}`)
+                      .join(' ')}
+                    {' '}(a symmetry reduction could store up to{' '}
+                    {verificationResult.symmetry.maxReduction.toLocaleString()}× fewer states)
+                  </Typography>
+                )}
               </Alert>
 
               {/* Result View Tabs */}
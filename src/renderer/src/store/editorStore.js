@@ -381,6 +381,10 @@ const useEditorStore = create((set, get) => ({
       ]
     }
   },
+  // 模板、实例和对称组只能从模型文件载入，原样传给后端（格式见 tck_model.js）
+  templates: {},
+  instances: [],
+  symmetryGroups: [],
   activeProcess: 'worker',
   mode: 'select',
   simulationResult: null,
@@ -811,7 +815,10 @@ const useEditorStore = create((set, get) => ({
       intVars: state.intVars,
       events: state.events,
       synchronizations: state.synchronizations,
-      processes: state.processes
+      processes: state.processes,
+      templates: state.templates,
+      instances: state.instances,
+      symmetryGroups: state.symmetryGroups
     }
 
     try {
@@ -844,6 +851,9 @@ const useEditorStore = create((set, get) => ({
           events: modelData.events || [],
           synchronizations: modelData.synchronizations || [],
           processes: modelData.processes || {},
+          templates: modelData.templates || {},
+          instances: modelData.instances || [],
+          symmetryGroups: modelData.symmetryGroups || [],
           activeProcess: Object.keys(modelData.processes || {})[0] || null,
           // Reset simulation state when loading new model
           simulatorInitialized: false,
@@ -930,7 +940,10 @@ const useEditorStore = create((set, get) => ({
       intVars: state.intVars,
       events: combinedEvents,
       synchronizations: state.synchronizations,
-      processes: convertedProcesses
+      processes: convertedProcesses,
+      templates: state.templates,
+      instances: state.instances,
+      symmetryGroups: state.symmetryGroups
     }
   },
 
@@ -978,7 +991,7 @@ const useEditorStore = create((set, get) => ({
     if (!Array.isArray(backendTransitions)) return []
 
     return backendTransitions.map((edge, index) => {
-      // DOT格式：{id, source, target, attributes: {vedge: "<process@event>"}}
+      // 格式：{id, source, target, attributes: {vedge: "<process@event>"}, targetAttributes}
       const vedge = edge.attributes?.vedge || ''
 
       let processName = 'unknown'
@@ -1000,7 +1013,8 @@ const useEditorStore = create((set, get) => ({
         processName: processName.trim(),
         event: event.trim(),
         sourceLocation: edge.source || '',
-        targetLocation: edge.target || '',
+        // 交互式会话会附带目标状态的属性
+        targetLocation: edge.targetAttributes?.vloc || edge.target || '',
         guard: '', // DOT格式不直接提供guard信息
         action: '', // DOT格式不直接提供action信息
         edgeData: edge